@@ -0,0 +1,96 @@
+#ifndef ALEATORIO_H
+#define ALEATORIO_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
+
+/*
+    Gerador aleatório por sessão: PCG32 (XSH-RR), 16 bytes de estado
+
+    Cada GameState tem o seu: não há estado global nem trava, então qualquer
+    número de threads sorteia ao mesmo tempo sem disputa. A mesma semente
+    reproduz exatamente a mesma sequência (partidas repetíveis); sementes
+    diferentes escolhem também sequências (streams) diferentes.
+*/
+
+typedef struct {
+    uint64_t estado;
+    uint64_t incremento;            // Sempre ímpar: seleciona a sequência
+} Aleatorio;
+
+// splitmix64: espalha a semente (sementes vizinhas geram estados sem relação)
+static inline uint64_t aleatorio_misturar(uint64_t* x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static inline uint32_t aleatorio_proximo(Aleatorio* a) {
+    uint64_t anterior = a->estado;
+    a->estado = anterior * 6364136223846793005ull + a->incremento;
+    uint32_t xorshifted = (uint32_t)(((anterior >> 18) ^ anterior) >> 27);
+    uint32_t rotacao = (uint32_t)(anterior >> 59);
+    return (xorshifted >> rotacao) | (xorshifted << ((32 - rotacao) & 31));
+}
+
+static inline void aleatorio_semear(Aleatorio* a, uint64_t semente) {
+    uint64_t x = semente;
+    uint64_t inicial = aleatorio_misturar(&x);
+    a->incremento = (aleatorio_misturar(&x) << 1) | 1u;
+    a->estado = 0;
+    aleatorio_proximo(a);
+    a->estado += inicial;
+    aleatorio_proximo(a);
+}
+
+/*
+    Inteiro uniforme em [0, n) sem viés (método de Lemire: multiplicação
+    de 32x32 bits; só descarta um sorteio na faixa que `%` favoreceria,
+    e só então paga uma divisão)
+*/
+static inline uint32_t aleatorio_limite(Aleatorio* a, uint32_t n) {
+    uint64_t m = (uint64_t)aleatorio_proximo(a) * n;
+    uint32_t baixo = (uint32_t)m;
+    if (baixo < n) {
+        uint32_t limiar = (0u - n) % n;             // 2^32 mod n
+        while (baixo < limiar) {
+            m = (uint64_t)aleatorio_proximo(a) * n;
+            baixo = (uint32_t)m;
+        }
+    }
+    return (uint32_t)(m >> 32);
+}
+
+/*
+    Semente imprevisível para quando o jogador não fixou uma: entropia do
+    sistema (/dev/urandom) ou, sem ela, relógio de alta resolução e número
+    do processo, misturados (duas sessões no mesmo segundo não coincidem)
+*/
+static inline uint64_t aleatorio_semente_sistema(void) {
+    uint64_t semente = 0;
+    #ifdef _WIN32
+        LARGE_INTEGER contagem;
+        QueryPerformanceCounter(&contagem);
+        semente = (uint64_t)contagem.QuadPart ^ ((uint64_t)GetCurrentProcessId() << 32);
+    #else
+        FILE* f = fopen("/dev/urandom", "rb");
+        if (!f || fread(&semente, sizeof(semente), 1, f) != 1) {
+            struct timespec ts;
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            semente = (uint64_t)ts.tv_nsec ^ ((uint64_t)ts.tv_sec << 30) ^ ((uint64_t)getpid() << 48);
+        }
+        if (f) fclose(f);
+    #endif
+    uint64_t x = semente ^ (uint64_t)time(NULL);
+    return aleatorio_misturar(&x);
+}
+
+#endif
@@ -0,0 +1,111 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+
+#define ARENA_ALINHAMENTO 16
+
+struct ArenaBloco {
+    ArenaBloco* anterior;   // Bloco preenchido antes deste
+    size_t capacidade;      // Bytes de dados disponíveis no bloco
+    size_t usado;           // Bytes de dados já entregues
+};
+
+// Os dados começam logo após o cabeçalho, já alinhados
+#define ARENA_CABECALHO ((sizeof(ArenaBloco) + ARENA_ALINHAMENTO - 1) & ~(size_t)(ARENA_ALINHAMENTO - 1))
+#define ARENA_DADOS(b) ((unsigned char*)(b) + ARENA_CABECALHO)
+
+static size_t alinhar(size_t n) {
+    return (n + ARENA_ALINHAMENTO - 1) & ~(size_t)(ARENA_ALINHAMENTO - 1);
+}
+
+void arena_iniciar(Arena* arena) {
+    arena->atual = NULL;
+    arena->reservado = 0;
+}
+
+// Abre um bloco novo com pelo menos `minimo` bytes de dados
+static ArenaBloco* novo_bloco(Arena* arena, size_t minimo) {
+    size_t capacidade = minimo > ARENA_BLOCO_PADRAO ? minimo : ARENA_BLOCO_PADRAO;
+    ArenaBloco* b = malloc(ARENA_CABECALHO + capacidade);
+    if (!b) return NULL;
+    b->anterior = arena->atual;
+    b->capacidade = capacidade;
+    b->usado = 0;
+    arena->atual = b;
+    arena->reservado += capacidade;
+    return b;
+}
+
+void* arena_alocar(Arena* arena, size_t tamanho) {
+    size_t n = alinhar(tamanho ? tamanho : 1);
+    ArenaBloco* b = arena->atual;
+    if (!b || b->capacidade - b->usado < n) {
+        // Bloco novo (do tamanho exato, se o pedido for grande) passa a ser o atual; o resto do
+        // anterior fica sem uso, mas a nova alocação continua sendo a última (cresce no lugar)
+        b = novo_bloco(arena, n);
+        if (!b) return NULL;
+    }
+    void* p = ARENA_DADOS(b) + b->usado;
+    b->usado += n;
+    return p;
+}
+
+void* arena_redimensionar(Arena* arena, void* ptr, size_t antigo, size_t novo) {
+    if (!ptr) return arena_alocar(arena, novo);
+
+    ArenaBloco* b = arena->atual;
+    size_t n_antigo = alinhar(antigo ? antigo : 1);
+    size_t n_novo = alinhar(novo ? novo : 1);
+    int ultima = b && (unsigned char*)ptr + n_antigo == ARENA_DADOS(b) + b->usado;
+
+    if (ultima && (unsigned char*)ptr == ARENA_DADOS(b)) {
+        // Única alocação do bloco: o bloco inteiro acompanha o novo tamanho
+        ArenaBloco* r = realloc(b, ARENA_CABECALHO + n_novo);
+        if (!r) {
+            if (n_novo <= n_antigo) return ptr;     // Encolher sem realloc ainda é válido
+            return NULL;
+        }
+        arena->reservado = arena->reservado - r->capacidade + n_novo;
+        r->capacidade = n_novo;
+        r->usado = n_novo;
+        arena->atual = r;
+        return ARENA_DADOS(r);
+    }
+    if (ultima && b->usado - n_antigo + n_novo <= b->capacidade) {
+        b->usado = b->usado - n_antigo + n_novo;     // Cresce/encolhe no lugar
+        return ptr;
+    }
+    if (n_novo <= n_antigo) return ptr;             // Encolher no meio do bloco: sobra fica sem uso
+
+    void* p = arena_alocar(arena, novo);
+    if (!p) return NULL;
+    memcpy(p, ptr, antigo);
+    return p;
+}
+
+void arena_absorver(Arena* destino, Arena* origem) {
+    if (!origem->atual) return;
+    if (!destino->atual) {
+        *destino = *origem;
+    } else {
+        // Os blocos da origem entram atrás do bloco atual do destino, que
+        // continua recebendo as próximas alocações
+        ArenaBloco* primeiro = origem->atual;
+        while (primeiro->anterior) primeiro = primeiro->anterior;
+        primeiro->anterior = destino->atual->anterior;
+        destino->atual->anterior = origem->atual;
+        destino->reservado += origem->reservado;
+    }
+    arena_iniciar(origem);
+}
+
+void arena_liberar(Arena* arena) {
+    ArenaBloco* b = arena->atual;
+    while (b) {
+        ArenaBloco* anterior = b->anterior;
+        free(b);
+        b = anterior;
+    }
+    arena_iniciar(arena);
+}
@@ -0,0 +1,43 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+/*
+    Arena de memória: alocações sequentes dentro de blocos grandes, liberadas
+    todas de uma vez em arena_liberar (não há free individual)
+
+    A última alocação pode crescer ou encolher no lugar; se ela ocupa um
+    bloco sozinha, o próprio bloco é realocado para o tamanho exato.
+    Não é thread-safe: cada thread usa sua própria arena e, ao final, os
+    blocos podem ser transferidos para outra com arena_absorver.
+*/
+
+#define ARENA_BLOCO_PADRAO (16 * 1024)  // Tamanho mínimo de um bloco novo
+
+typedef struct ArenaBloco ArenaBloco;
+
+typedef struct {
+    ArenaBloco* atual;      // Bloco das próximas alocações (os anteriores ficam encadeados)
+    size_t reservado;       // Soma das capacidades dos blocos (bytes pedidos ao sistema)
+} Arena;
+
+void arena_iniciar(Arena* arena);
+
+// Aloca `tamanho` bytes alinhados a 16; NULL se faltar memória
+void* arena_alocar(Arena* arena, size_t tamanho);
+
+/*
+    Muda o tamanho de uma alocação de `antigo` para `novo` bytes
+    Preserva o conteúdo (até o menor tamanho); pode devolver outro endereço
+    @return: Novo endereço ou NULL se faltar memória (a alocação original continua válida)
+*/
+void* arena_redimensionar(Arena* arena, void* ptr, size_t antigo, size_t novo);
+
+// Transfere todos os blocos de `origem` para `destino` (origem fica vazia)
+void arena_absorver(Arena* destino, Arena* origem);
+
+// Libera todos os blocos de uma vez
+void arena_liberar(Arena* arena);
+
+#endif
@@ -0,0 +1,297 @@
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bench.h"
+#include "aleatorio.h"
+#include "relogio.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #include <x86intrin.h>
+    #define BENCH_TSC 1
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #define BENCH_TSC 1
+#endif
+
+#ifdef __linux__
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+// ============================================================================
+// CONTAGEM DE ALOCAÇÕES (-Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc)
+// ============================================================================
+
+#ifdef BENCH_ALOCACOES
+static uint64_t alocacoes;              // Chamadas desde o início (atômico: a carga paralela usa threads)
+static uint64_t bytes_alocados;
+
+void* __real_malloc(size_t n);
+void* __real_calloc(size_t n, size_t tamanho);
+void* __real_realloc(void* p, size_t n);
+
+void* __wrap_malloc(size_t n) {
+    __atomic_fetch_add(&alocacoes, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&bytes_alocados, n, __ATOMIC_RELAXED);
+    return __real_malloc(n);
+}
+
+void* __wrap_calloc(size_t n, size_t tamanho) {
+    __atomic_fetch_add(&alocacoes, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&bytes_alocados, n * tamanho, __ATOMIC_RELAXED);
+    return __real_calloc(n, tamanho);
+}
+
+void* __wrap_realloc(void* p, size_t n) {
+    __atomic_fetch_add(&alocacoes, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&bytes_alocados, n, __ATOMIC_RELAXED);
+    return __real_realloc(p, n);
+}
+
+#define ALOCACOES() __atomic_load_n(&alocacoes, __ATOMIC_RELAXED)
+#define BYTES_ALOCADOS() __atomic_load_n(&bytes_alocados, __ATOMIC_RELAXED)
+#else
+#define ALOCACOES() 0
+#define BYTES_ALOCADOS() 0
+#endif
+
+// ============================================================================
+// CICLOS
+// ============================================================================
+
+// Contador de ciclos da própria thread, só em modo usuário; -1 se o kernel não permite
+static int abrir_perf(void) {
+    #ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CPU_CYCLES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    #else
+    return -1;
+    #endif
+}
+
+static uint64_t ler_ciclos(const Bench* b) {
+    #ifdef __linux__
+    if (b->perf_fd >= 0) {
+        uint64_t valor = 0;
+        if (read(b->perf_fd, &valor, sizeof(valor)) != (ssize_t)sizeof(valor)) return 0;
+        return valor;
+    }
+    #endif
+    #ifdef BENCH_TSC
+    if (b->fonte_ciclos) return __rdtsc();
+    #endif
+    (void)b;
+    return 0;
+}
+
+// ============================================================================
+// MEDIÇÃO E SAÍDA
+// ============================================================================
+
+// Uma repetição de um caso
+typedef struct {
+    uint64_t ns;
+    uint64_t ciclos;
+    uint64_t alocacoes;
+    uint64_t bytes;
+} Amostra;
+
+static Amostra executar(Bench* b, BenchCaso caso, void* contexto, uint64_t iteracoes) {
+    Amostra a;
+    uint64_t alocacoes0 = ALOCACOES(), bytes0 = BYTES_ALOCADOS();
+    #ifdef __linux__
+    if (b->perf_fd >= 0) ioctl(b->perf_fd, PERF_EVENT_IOC_ENABLE, 0);
+    #endif
+    uint64_t ciclos0 = ler_ciclos(b);
+    uint64_t inicio = agora_nanossegundos();
+    caso(contexto, iteracoes);
+    a.ns = agora_nanossegundos() - inicio;
+    a.ciclos = ler_ciclos(b) - ciclos0;
+    #ifdef __linux__
+    if (b->perf_fd >= 0) ioctl(b->perf_fd, PERF_EVENT_IOC_DISABLE, 0);
+    #endif
+    a.alocacoes = ALOCACOES() - alocacoes0;
+    a.bytes = BYTES_ALOCADOS() - bytes0;
+    return a;
+}
+
+static int comparar_amostras(const void* a, const void* b) {
+    uint64_t x = ((const Amostra*)a)->ns, y = ((const Amostra*)b)->ns;
+    return (x > y) - (x < y);
+}
+
+int bench_iniciar(Bench* b, const char* arquivo_json) {
+    memset(b, 0, sizeof(*b));
+    b->json = fopen(arquivo_json, "w");
+    if (!b->json) return 0;
+
+    b->perf_fd = abrir_perf();
+    if (b->perf_fd >= 0) b->fonte_ciclos = "perf";
+    #ifdef BENCH_TSC
+    else b->fonte_ciclos = "tsc";
+    #endif
+
+    char data[32];
+    time_t agora = time(NULL);
+    strftime(data, sizeof(data), "%Y-%m-%dT%H:%M:%SZ", gmtime(&agora));
+    fprintf(b->json, "{\n  \"versao\": 1,\n  \"data\": \"%s\",\n", data);
+    #ifdef __VERSION__
+    fprintf(b->json, "  \"compilador\": \"%s\",\n", __VERSION__);
+    #endif
+    if (b->fonte_ciclos) fprintf(b->json, "  \"ciclos\": \"%s\",\n", b->fonte_ciclos);
+    else fprintf(b->json, "  \"ciclos\": null,\n");
+    #ifdef BENCH_ALOCACOES
+    fprintf(b->json, "  \"alocacoes\": true,\n");
+    #else
+    fprintf(b->json, "  \"alocacoes\": false,\n");
+    #endif
+    fprintf(b->json, "  \"repeticoes\": %d,\n  \"casos\": [", BENCH_REPETICOES);
+    return 1;
+}
+
+void bench_medir(Bench* b, const char* nome, BenchCaso caso, void* contexto) {
+    // Calibração: dobra as iterações até uma repetição durar o mínimo (a primeira também aquece)
+    uint64_t iteracoes = 1;
+    while (iteracoes < BENCH_MAX_ITERACOES &&
+           executar(b, caso, contexto, iteracoes).ns < (uint64_t)(BENCH_TEMPO_MINIMO * 1e9)) {
+        iteracoes *= 2;
+    }
+
+    Amostra amostras[BENCH_REPETICOES];
+    uint64_t alocacoes = 0, bytes = 0;
+    for (int i = 0; i < BENCH_REPETICOES; i++) {
+        amostras[i] = executar(b, caso, contexto, iteracoes);
+        alocacoes += amostras[i].alocacoes;
+        bytes += amostras[i].bytes;
+    }
+    qsort(amostras, BENCH_REPETICOES, sizeof(Amostra), comparar_amostras);
+    const Amostra* mediana = &amostras[BENCH_REPETICOES / 2];
+    double total = (double)iteracoes * BENCH_REPETICOES;
+    double ns_op = (double)mediana->ns / iteracoes;
+    double ns_min = (double)amostras[0].ns / iteracoes;
+
+    fprintf(b->json, "%s\n    {\"nome\": \"%s\", \"iteracoes\": %llu, \"ns_op\": %.2f, \"ns_op_min\": %.2f, ",
+            b->casos ? "," : "", nome, (unsigned long long)iteracoes, ns_op, ns_min);
+    if (b->fonte_ciclos) fprintf(b->json, "\"ciclos_op\": %.1f, ", (double)mediana->ciclos / iteracoes);
+    else fprintf(b->json, "\"ciclos_op\": null, ");
+    #ifdef BENCH_ALOCACOES
+    fprintf(b->json, "\"alocacoes_op\": %.3f, \"bytes_alocados_op\": %.1f}", alocacoes / total, bytes / total);
+    #else
+    (void)alocacoes;
+    (void)bytes;
+    (void)total;
+    fprintf(b->json, "\"alocacoes_op\": null, \"bytes_alocados_op\": null}");
+    #endif
+    b->casos++;
+
+    printf("  %-28s %12.1f ns/op", nome, ns_op);
+    if (b->fonte_ciclos) printf(" %12.1f ciclos/op", (double)mediana->ciclos / iteracoes);
+    #ifdef BENCH_ALOCACOES
+    printf(" %8.2f aloc/op", alocacoes / total);
+    #endif
+    printf("  (%llu x %d)\n", (unsigned long long)iteracoes, BENCH_REPETICOES);
+    fflush(stdout);
+}
+
+int bench_concluir(Bench* b) {
+    fprintf(b->json, "\n  ]\n}\n");
+    int ok = !ferror(b->json);
+    ok = (fclose(b->json) == 0) && ok;
+    b->json = NULL;
+    #ifdef __linux__
+    if (b->perf_fd >= 0) close(b->perf_fd);
+    #endif
+    b->perf_fd = -1;
+    return ok;
+}
+
+// ============================================================================
+// CASOS DO MOTOR
+// ============================================================================
+
+#define BENCH_PALAVRAS 4096             // Entradas distintas por caso (potência de 2: índice com máscara)
+
+typedef struct {
+    const char* arquivo;
+    GameState inicial;                  // Partida recém-sorteada (process_guess volta a ela)
+    GameState game;
+    char textos[BENCH_PALAVRAS][WORD_LENGTH + 1]; // Metade existentes, metade com uma letra trocada
+    uint64_t chaves[BENCH_PALAVRAS];    // Tentativas empacotadas (palavras existentes)
+    volatile uint64_t sumidouro;        // Impede que o compilador descarte os resultados
+} ContextoMotor;
+
+static void caso_carregar(void* contexto, uint64_t iteracoes) {
+    ContextoMotor* c = contexto;
+    for (uint64_t i = 0; i < iteracoes; i++) {
+        Arena arena;
+        ListaPalavras lista;
+        arena_iniciar(&arena);
+        memset(&lista, 0, sizeof(lista));
+        c->sumidouro += (uint64_t)carregar_palavras(&arena, &lista, c->arquivo, NULL);
+        arena_liberar(&arena);
+    }
+}
+
+static void caso_existe(void* contexto, uint64_t iteracoes) {
+    ContextoMotor* c = contexto;
+    uint64_t achadas = 0;
+    for (uint64_t i = 0; i < iteracoes; i++) {
+        achadas += (uint64_t)check_word_exists(&c->game, c->textos[i & (BENCH_PALAVRAS - 1)]);
+    }
+    c->sumidouro += achadas;
+}
+
+static void caso_feedback(void* contexto, uint64_t iteracoes) {
+    ContextoMotor* c = contexto;
+    uint64_t soma = 0;
+    for (uint64_t i = 0; i < iteracoes; i++) {
+        calculate_feedback(&c->game, c->chaves[i & (BENCH_PALAVRAS - 1)]);
+        soma += c->game.padroes[0];
+    }
+    c->sumidouro += soma;
+}
+
+static void caso_tentativa(void* contexto, uint64_t iteracoes) {
+    ContextoMotor* c = contexto;
+    for (uint64_t i = 0; i < iteracoes; i++) {
+        // Partida encerrada: volta à inicial (cópia de 144 bytes, incluída na medida)
+        if (c->game.game_over) c->game = c->inicial;
+        process_guess(&c->game, c->textos[(i & (BENCH_PALAVRAS / 2 - 1)) * 2]);
+    }
+    c->sumidouro += c->game.current_attempt;
+}
+
+void bench_motor(Bench* b, const Motor* motor, const char* arquivo_palavras) {
+    ContextoMotor* c = calloc(1, sizeof(ContextoMotor));
+    if (!c) return;
+    c->arquivo = arquivo_palavras;
+
+    // Entradas fixas (semente constante): resultados comparáveis entre execuções
+    Aleatorio rng;
+    aleatorio_semear(&rng, 2024);
+    for (int i = 0; i < BENCH_PALAVRAS; i++) {
+        uint32_t chave = motor->normal->palavras[aleatorio_limite(&rng, (uint32_t)motor->normal->n)];
+        c->chaves[i] = chave;
+        unpack_word(chave, c->textos[i]);
+        if (i & 1) c->textos[i][aleatorio_limite(&rng, WORD_LENGTH)] = (char)('A' + aleatorio_limite(&rng, 26));
+    }
+    init_game(&c->inicial, motor, MEDIUM, 2024);
+    c->game = c->inicial;
+
+    bench_medir(b, "carregar_palavras", caso_carregar, c);
+    bench_medir(b, "check_word_exists", caso_existe, c);
+    bench_medir(b, "calculate_feedback", caso_feedback, c);
+    c->game = c->inicial;
+    bench_medir(b, "process_guess", caso_tentativa, c);
+    free(c);
+}
@@ -0,0 +1,57 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "motor.h"
+
+/*
+    Micro-benchmarks dos caminhos quentes (modo --bench, alvo `make bench`)
+
+    Cada caso é uma função que executa `iteracoes` operações. O número de
+    iterações é calibrado (dobrando até uma repetição durar pelo menos
+    BENCH_TEMPO_MINIMO) e o caso roda BENCH_REPETICOES vezes; o resultado é
+    a mediana de ns/op, o mínimo, ciclos/op e alocações/op.
+
+    Ciclos: contador de hardware do perf_event (Linux) quando o kernel
+    permite; senão o TSC (x86, ciclos de referência); senão ficam null.
+    Alocações: só quando compilado com BENCH_ALOCACOES e as chamadas de
+    malloc/calloc/realloc desviadas pelo linker (-Wl,--wrap=..., ver
+    Makefile); contam as alocações feitas pelo código do jogo, não as
+    internas da libc (ex.: buffer de fopen). Sem isso ficam null.
+
+    Saída em JSON (um objeto com a lista de casos) para comparar versões,
+    e uma linha por caso em stdout.
+*/
+
+#define BENCH_REPETICOES 7              // Repetições de cada caso (mediana)
+#define BENCH_TEMPO_MINIMO 0.05         // Duração mínima de uma repetição (segundos)
+#define BENCH_MAX_ITERACOES (1ull << 32) // Limite da calibração
+
+// Executa `iteracoes` operações do caso
+typedef void (*BenchCaso)(void* contexto, uint64_t iteracoes);
+
+typedef struct {
+    FILE* json;                 // Arquivo de saída
+    int casos;                  // Casos já escritos
+    int perf_fd;                // Contador de ciclos do perf_event (-1 = indisponível)
+    const char* fonte_ciclos;   // "perf", "tsc" ou NULL
+} Bench;
+
+// Cria o arquivo JSON e escolhe a fonte de ciclos; 0 se o arquivo não abriu
+int bench_iniciar(Bench* b, const char* arquivo_json);
+
+// Calibra, mede e registra um caso
+void bench_medir(Bench* b, const char* nome, BenchCaso caso, void* contexto);
+
+// Fecha o JSON; 0 em caso de erro de escrita
+int bench_concluir(Bench* b);
+
+/*
+    Casos do motor: carregar_palavras (lendo `arquivo_palavras`),
+    check_word_exists, calculate_feedback e process_guess
+*/
+void bench_motor(Bench* b, const Motor* motor, const char* arquivo_palavras);
+
+#endif
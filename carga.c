@@ -0,0 +1,223 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "carga.h"
+#include "servidor.h"
+#include "relogio.h"
+
+#ifdef __linux__
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <poll.h>
+    #include <unistd.h>
+    #include <sys/epoll.h>
+    #include <sys/socket.h>
+#endif
+
+#ifdef __linux__
+
+// Estado de uma conexão do gerador
+typedef struct {
+    int fd;
+    int jogos_restantes;
+    double envio;                       // Instante em que a requisição atual foi enviada
+    Aleatorio rng;                      // Sorteio das palavras desta conexão
+    char entrada[SERVIDOR_MAX_LINHA];
+    int n_entrada;
+} Cliente;
+
+typedef struct {
+    const Motor* motor;
+    int epoll_fd;
+    int nivel;                          // Dificuldade pedida em cada NEW
+    double* latencias;                  // Uma por requisição respondida (segundos)
+    size_t n_latencias, cap_latencias;
+    unsigned long jogos, vitorias, erros;
+    int ativas;
+} Carga;
+
+static int comparar_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Envia a linha inteira (requisições curtas quase nunca encontram o socket cheio)
+// Socket cheio (servidor atrasado): dorme em poll até caber, sem girar a CPU que está sendo medida
+static int enviar(Cliente* cl, const char* linha) {
+    size_t total = strlen(linha), enviado = 0;
+    cl->envio = agora_segundos();
+    while (enviado < total) {
+        ssize_t n = send(cl->fd, linha + enviado, total - enviado, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                struct pollfd pfd = { .fd = cl->fd, .events = POLLOUT };
+                if (poll(&pfd, 1, -1) < 0 && errno != EINTR) return 0;
+                continue;                       // POLLERR/POLLHUP: o próximo send devolve o erro
+            }
+            return 0;
+        }
+        enviado += (size_t)n;
+    }
+    return 1;
+}
+
+static int enviar_palpite(Carga* c, Cliente* cl) {
+    char linha[32], palavra[WORD_LENGTH + 1];
+    int idx = (int)aleatorio_limite(&cl->rng, (uint32_t)c->motor->normal->n);
+    unpack_word(c->motor->normal->palavras[idx], palavra);
+    snprintf(linha, sizeof(linha), "GUESS %s\n", palavra);
+    return enviar(cl, linha);
+}
+
+static int enviar_novo(Carga* c, Cliente* cl) {
+    char linha[16];
+    snprintf(linha, sizeof(linha), "NEW %d\n", c->nivel);
+    return enviar(cl, linha);
+}
+
+/*
+    Trata uma resposta e envia a próxima requisição da conexão
+    @return: 0 quando a conexão terminou seus jogos (ou falhou)
+*/
+static int tratar_resposta(Carga* c, Cliente* cl, const char* linha) {
+    if (c->n_latencias == c->cap_latencias) {
+        size_t cap = c->cap_latencias ? c->cap_latencias * 2 : 4096;
+        double* novo = realloc(c->latencias, cap * sizeof(double));
+        if (!novo) return 0;
+        c->latencias = novo;
+        c->cap_latencias = cap;
+    }
+    c->latencias[c->n_latencias++] = agora_segundos() - cl->envio;
+
+    if (strncmp(linha, "OK", 2) == 0) return enviar_palpite(c, cl);
+    if (strncmp(linha, "FB", 2) == 0) {
+        if (strstr(linha, "JOGANDO")) return enviar_palpite(c, cl);
+        c->jogos++;
+        if (strstr(linha, "VENCEU")) c->vitorias++;
+    } else {
+        c->erros++;                                 // ERR: recomeça com uma nova partida
+    }
+    if (--cl->jogos_restantes <= 0) return 0;
+    return enviar_novo(c, cl);
+}
+
+static int ler_respostas(Carga* c, Cliente* cl) {
+    for (;;) {
+        ssize_t n = recv(cl->fd, cl->entrada + cl->n_entrada, (size_t)(SERVIDOR_MAX_LINHA - cl->n_entrada), 0);
+        if (n == 0) return 0;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        cl->n_entrada += (int)n;
+
+        int inicio = 0;
+        char* fim;
+        while ((fim = memchr(cl->entrada + inicio, '\n', (size_t)(cl->n_entrada - inicio))) != NULL) {
+            *fim = '\0';
+            if (!tratar_resposta(c, cl, cl->entrada + inicio)) return 0;
+            inicio = (int)(fim - cl->entrada) + 1;
+        }
+        memmove(cl->entrada, cl->entrada + inicio, (size_t)(cl->n_entrada - inicio));
+        cl->n_entrada -= inicio;
+        if (cl->n_entrada == SERVIDOR_MAX_LINHA) return 0;   // Resposta inválida
+    }
+}
+
+int carga_executar(const Motor* motor, const char* endereco, int conexoes, int jogos) {
+    if (conexoes < 1) conexoes = 1;
+    if (jogos < 1) jogos = 1;
+
+    Carga c;
+    memset(&c, 0, sizeof(c));
+    c.motor = motor;
+    c.nivel = MEDIUM;
+    c.epoll_fd = epoll_create1(0);
+    Cliente* clientes = calloc((size_t)conexoes, sizeof(Cliente));
+    if (c.epoll_fd < 0 || !clientes) {
+        printf("Erro: não foi possível iniciar o gerador de carga\n");
+        free(clientes);
+        return 1;
+    }
+
+    // Conecta todas antes de medir
+    for (int i = 0; i < conexoes; i++) {
+        Cliente* cl = &clientes[i];
+        cl->fd = servidor_conectar(endereco);
+        if (cl->fd < 0) {
+            printf("Erro: conexão %d com %s falhou\n", i + 1, endereco);
+            for (int j = 0; j < i; j++) close(clientes[j].fd);
+            free(clientes);
+            close(c.epoll_fd);
+            return 1;
+        }
+        cl->jogos_restantes = jogos;
+        aleatorio_semear(&cl->rng, (uint64_t)(i + 1));  // Fixa: a mesma carga a cada execução
+        int flags = fcntl(cl->fd, F_GETFL, 0);
+        fcntl(cl->fd, F_SETFL, flags | O_NONBLOCK);
+
+        struct epoll_event ev;
+        ev.events = EPOLLIN;
+        ev.data.ptr = cl;
+        epoll_ctl(c.epoll_fd, EPOLL_CTL_ADD, cl->fd, &ev);
+    }
+
+    printf("Gerador de carga: %d conexão(ões) x %d jogo(s) em %s\n", conexoes, jogos, endereco);
+    double inicio = agora_segundos();
+    for (int i = 0; i < conexoes; i++) {
+        if (enviar_novo(&c, &clientes[i])) c.ativas++;
+        else close(clientes[i].fd);
+    }
+
+    struct epoll_event eventos[256];
+    while (c.ativas > 0) {
+        int n = epoll_wait(c.epoll_fd, eventos, 256, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        for (int i = 0; i < n; i++) {
+            Cliente* cl = eventos[i].data.ptr;
+            if (!ler_respostas(&c, cl)) {
+                epoll_ctl(c.epoll_fd, EPOLL_CTL_DEL, cl->fd, NULL);
+                close(cl->fd);
+                c.ativas--;
+            }
+        }
+    }
+    double duracao = agora_segundos() - inicio;
+
+    if (c.n_latencias > 0) {
+        qsort(c.latencias, c.n_latencias, sizeof(double), comparar_double);
+        double p50 = c.latencias[c.n_latencias / 2];
+        double p99 = c.latencias[(size_t)((double)(c.n_latencias - 1) * 0.99)];
+        double max = c.latencias[c.n_latencias - 1];
+        printf("Requisições: %zu em %.3fs (%.0f req/s, %.0f jogos/s)\n",
+               c.n_latencias, duracao, (double)c.n_latencias / duracao, (double)c.jogos / duracao);
+        printf("Latência: p50 %.1f us | p99 %.1f us | máx %.1f us\n",
+               p50 * 1e6, p99 * 1e6, max * 1e6);
+        printf("Jogos: %lu (%lu vitória(s)), erros: %lu\n", c.jogos, c.vitorias, c.erros);
+    } else {
+        printf("Nenhuma resposta recebida\n");
+    }
+
+    free(c.latencias);
+    free(clientes);
+    close(c.epoll_fd);
+    return c.n_latencias > 0 ? 0 : 1;
+}
+
+#else
+
+int carga_executar(const Motor* motor, const char* endereco, int conexoes, int jogos) {
+    (void)motor;
+    (void)endereco;
+    (void)conexoes;
+    (void)jogos;
+    printf("Erro: o gerador de carga requer Linux (epoll)\n");
+    return 1;
+}
+
+#endif
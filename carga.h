@@ -0,0 +1,17 @@
+#ifndef CARGA_H
+#define CARGA_H
+
+#include "motor.h"
+
+/*
+    Gerador de carga para o servidor de partidas
+    Abre `conexoes` conexões simultâneas; cada uma joga `jogos` partidas
+    (NEW + GUESS com palavras sorteadas do dicionário até o fim do jogo),
+    sempre com uma requisição em andamento por conexão.
+    Mede a latência de cada requisição (envio -> resposta) e imprime
+    vazão, p50, p99 e máximo.
+*/
+
+int carga_executar(const Motor* motor, const char* endereco, int conexoes, int jogos);
+
+#endif
@@ -0,0 +1,237 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "dicionario.h"
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+// Cabeçalho do artefato (72 bytes, seguido pelas palavras e pelos slots)
+typedef struct {
+    char magic[8];                  // "CODLECDC"
+    uint32_t versao;                // DICIONARIO_VERSAO
+    uint32_t word_length;           // Comprimento das palavras
+    uint32_t n_normal;              // Palavras da lista normal
+    uint32_t n_dificil;             // Palavras da lista difícil
+    uint32_t indice_bits;           // log2 da capacidade do índice
+    uint32_t reservado;             // Sempre 0 (alinhamento)
+    uint64_t fonte_tamanho[2];      // Tamanho dos .txt de origem
+    int64_t fonte_mtime[2];         // Data de modificação dos .txt de origem
+    uint64_t checksum;              // checksum_conteudo de palavras + slots
+} DicionarioHeader;
+
+// Limite de sanidade por lista (as listas não têm tamanho fixo)
+#define DICIONARIO_MAX_PALAVRAS (1u << 24)
+
+static const char DICIONARIO_MAGIC[8] = { 'C', 'O', 'D', 'L', 'E', 'C', 'D', 'C' };
+
+/*
+    Checksum do conteúdo: FNV-1a 64 aplicado a palavras de 32 bits inteiras
+    (uma multiplicação por palavra em vez de uma por byte: conferir o artefato
+    a cada inicialização custa bem menos que analisar os .txt)
+*/
+static uint64_t checksum_conteudo(const uint32_t* conteudo, uint32_t n) {
+    uint64_t h = 14695981039346656037ull;
+    for (uint32_t i = 0; i < n; i++) {
+        h ^= conteudo[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+// Tamanho e data de modificação de um arquivo de origem
+static int identificar_fonte(const char* caminho, uint64_t* tamanho, int64_t* mtime) {
+    struct stat st;
+    if (stat(caminho, &st) != 0) return 0;
+    *tamanho = (uint64_t)st.st_size;
+    *mtime = (int64_t)st.st_mtime;
+    return 1;
+}
+
+int dicionario_compilar(const Motor* motor, const char* caminho,
+                        const char* fonte_normal, const char* fonte_dificil) {
+    if (!motor->index.slots) return 0;
+
+    DicionarioHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, DICIONARIO_MAGIC, sizeof(DICIONARIO_MAGIC));
+    h.versao = DICIONARIO_VERSAO;
+    h.word_length = WORD_LENGTH;
+    h.n_normal = (uint32_t)motor->normal->n;
+    h.n_dificil = (uint32_t)motor->dificil->n;
+    h.indice_bits = (uint32_t)motor->index.bits;
+    if (!identificar_fonte(fonte_normal, &h.fonte_tamanho[0], &h.fonte_mtime[0]) ||
+        !identificar_fonte(fonte_dificil, &h.fonte_tamanho[1], &h.fonte_mtime[1])) {
+        return 0;
+    }
+
+    // Conteúdo contíguo para o checksum: palavras normais, difíceis e slots
+    uint32_t n_slots = 1u << h.indice_bits;
+    uint32_t n_total = h.n_normal + h.n_dificil + n_slots;
+    uint32_t* conteudo = malloc((size_t)n_total * sizeof(uint32_t));
+    if (!conteudo) return 0;
+    if (h.n_normal) memcpy(conteudo, motor->normal->palavras, (size_t)h.n_normal * sizeof(uint32_t));
+    if (h.n_dificil) memcpy(conteudo + h.n_normal, motor->dificil->palavras, (size_t)h.n_dificil * sizeof(uint32_t));
+    memcpy(conteudo + h.n_normal + h.n_dificil, motor->index.slots, (size_t)n_slots * sizeof(uint32_t));
+    h.checksum = checksum_conteudo(conteudo, n_total);
+
+    // Temporário + rename: outro processo nunca abre um artefato pela metade
+    char temporario[1024];
+    if (snprintf(temporario, sizeof(temporario), "%s.tmp", caminho) >= (int)sizeof(temporario)) {
+        free(conteudo);
+        return 0;
+    }
+    FILE* file = fopen(temporario, "wb");
+    if (!file) {
+        free(conteudo);
+        return 0;
+    }
+    int ok = fwrite(&h, sizeof(h), 1, file) == 1 &&
+             fwrite(conteudo, sizeof(uint32_t), n_total, file) == n_total;
+    ok = (fclose(file) == 0) && ok;
+    free(conteudo);
+    if (!ok) {
+        remove(temporario);
+        return 0;
+    }
+
+    #ifdef _WIN32
+    remove(caminho);                                // rename não sobrescreve no Windows
+    #endif
+    if (rename(temporario, caminho) != 0) {
+        remove(temporario);
+        return 0;
+    }
+    return 1;
+}
+
+// Mapeia (ou lê, no Windows) o arquivo inteiro
+static void* abrir_arquivo(const char* caminho, size_t* tamanho, int* mapeado) {
+    #ifdef _WIN32
+    FILE* file = fopen(caminho, "rb");
+    if (!file) return NULL;
+    fseek(file, 0, SEEK_END);
+    long n = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    void* dados = n > 0 ? malloc((size_t)n) : NULL;
+    if (!dados || fread(dados, 1, (size_t)n, file) != (size_t)n) {
+        free(dados);
+        fclose(file);
+        return NULL;
+    }
+    fclose(file);
+    *tamanho = (size_t)n;
+    *mapeado = 0;
+    return dados;
+    #else
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return NULL;
+    }
+    void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);                                      // O mapeamento continua válido sem o fd
+    if (map == MAP_FAILED) return NULL;
+    *tamanho = (size_t)st.st_size;
+    *mapeado = 1;
+    return map;
+    #endif
+}
+
+static void fechar_arquivo(void* dados, size_t tamanho, int mapeado) {
+    #ifndef _WIN32
+    if (mapeado) {
+        munmap(dados, tamanho);
+        return;
+    }
+    #endif
+    (void)tamanho;
+    (void)mapeado;
+    free(dados);
+}
+
+// Confere formato, limites e tamanho; o checksum é conferido depois
+static DicionarioEstado validar_header(const DicionarioHeader* h, size_t tamanho) {
+    if (tamanho < sizeof(*h) ||
+        memcmp(h->magic, DICIONARIO_MAGIC, sizeof(DICIONARIO_MAGIC)) != 0 ||
+        h->versao != DICIONARIO_VERSAO ||
+        h->word_length != WORD_LENGTH ||
+        h->n_normal > DICIONARIO_MAX_PALAVRAS || h->n_dificil > DICIONARIO_MAX_PALAVRAS ||
+        h->indice_bits < 4 || h->indice_bits > 30) {
+        return DICIONARIO_INVALIDO;
+    }
+    size_t esperado = sizeof(*h) +
+        ((size_t)h->n_normal + h->n_dificil + ((size_t)1 << h->indice_bits)) * sizeof(uint32_t);
+    return tamanho == esperado ? DICIONARIO_OK : DICIONARIO_INVALIDO;
+}
+
+DicionarioEstado dicionario_abrir(Motor* motor, const char* caminho,
+                                  const char* fonte_normal, const char* fonte_dificil) {
+    size_t tamanho;
+    int mapeado;
+    void* dados = abrir_arquivo(caminho, &tamanho, &mapeado);
+    if (!dados) return DICIONARIO_AUSENTE;
+
+    const DicionarioHeader* h = dados;
+    DicionarioEstado estado = validar_header(h, tamanho);
+
+    // Origem alterada (ou removida) depois da compilação
+    uint64_t fonte_tamanho;
+    int64_t fonte_mtime;
+    if (estado == DICIONARIO_OK &&
+        (!identificar_fonte(fonte_normal, &fonte_tamanho, &fonte_mtime) ||
+         fonte_tamanho != h->fonte_tamanho[0] || fonte_mtime != h->fonte_mtime[0] ||
+         !identificar_fonte(fonte_dificil, &fonte_tamanho, &fonte_mtime) ||
+         fonte_tamanho != h->fonte_tamanho[1] || fonte_mtime != h->fonte_mtime[1])) {
+        estado = DICIONARIO_DESATUALIZADO;
+    }
+
+    const uint32_t* conteudo = (const uint32_t*)(h + 1);
+    uint32_t n_total = 0;
+    if (estado == DICIONARIO_OK) {
+        n_total = h->n_normal + h->n_dificil + (1u << h->indice_bits);
+        if (checksum_conteudo(conteudo, n_total) != h->checksum) estado = DICIONARIO_INVALIDO;
+    }
+    if (estado != DICIONARIO_OK) {
+        fechar_arquivo(dados, tamanho, mapeado);
+        return estado;
+    }
+
+    // Listas copiadas para a arena do motor (continuam podendo crescer);
+    // o índice é usado direto do arquivo
+    motor_liberar(motor);
+    if (!motor_lista_reservar(motor, motor->normal, (int)h->n_normal) ||
+        !motor_lista_reservar(motor, motor->dificil, (int)h->n_dificil)) {
+        motor_liberar(motor);
+        fechar_arquivo(dados, tamanho, mapeado);
+        return DICIONARIO_INVALIDO;
+    }
+    if (h->n_normal) memcpy(motor->normal->palavras, conteudo, (size_t)h->n_normal * sizeof(uint32_t));
+    if (h->n_dificil) memcpy(motor->dificil->palavras, conteudo + h->n_normal, (size_t)h->n_dificil * sizeof(uint32_t));
+    motor->normal->n = (int)h->n_normal;
+    motor->dificil->n = (int)h->n_dificil;
+    motor->index.slots = (uint32_t*)(conteudo + h->n_normal + h->n_dificil);
+    motor->index.bits = (int)h->indice_bits;
+    motor->index.mask = (1u << h->indice_bits) - 1;
+    motor->artefato = dados;
+    motor->artefato_tamanho = tamanho;
+    motor->artefato_mapeado = mapeado;
+    return DICIONARIO_OK;
+}
+
+const char* dicionario_estado_nome(DicionarioEstado estado) {
+    switch (estado) {
+        case DICIONARIO_OK:            return "ok";
+        case DICIONARIO_AUSENTE:       return "ausente";
+        case DICIONARIO_DESATUALIZADO: return "desatualizado";
+        case DICIONARIO_INVALIDO:
+        default:                       return "inválido";
+    }
+}
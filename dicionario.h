@@ -0,0 +1,37 @@
+#ifndef DICIONARIO_H
+#define DICIONARIO_H
+
+#include "motor.h"
+
+/*
+    Dicionário compilado: as listas já empacotadas e o índice hash pronto
+    em um único arquivo binário, mapeado com mmap na inicialização
+
+    Formato: cabeçalho | palavras normais | palavras difíceis | slots do índice
+    O cabeçalho guarda tamanho e data de modificação dos .txt de origem
+    (para detectar um artefato desatualizado) e um checksum do conteúdo
+*/
+
+#define DICIONARIO_ARQUIVO "codlec.dic"     // Nome padrão do artefato
+#define DICIONARIO_VERSAO 2                 // Incrementar ao mudar o formato, o índice ou a normalização
+
+// Resultado de dicionario_abrir
+typedef enum {
+    DICIONARIO_OK = 0,              // Motor pronto a partir do artefato
+    DICIONARIO_AUSENTE,             // Arquivo não existe
+    DICIONARIO_DESATUALIZADO,       // Algum .txt de origem mudou depois da compilação
+    DICIONARIO_INVALIDO             // Formato, versão, tamanho ou checksum não conferem
+} DicionarioEstado;
+
+// Grava o artefato a partir de um motor carregado e indexado
+int dicionario_compilar(const Motor* motor, const char* caminho,
+                        const char* fonte_normal, const char* fonte_dificil);
+
+// Prepara o motor a partir do artefato (sem analisar texto nem reconstruir o índice)
+DicionarioEstado dicionario_abrir(Motor* motor, const char* caminho,
+                                  const char* fonte_normal, const char* fonte_dificil);
+
+// Descrição curta de um estado, para mensagens ao usuário
+const char* dicionario_estado_nome(DicionarioEstado estado);
+
+#endif
@@ -0,0 +1,218 @@
+#include "feedback.h"
+
+/*
+    Kernel de feedback sem desvios (branch-free)
+
+    Reproduz exatamente o algoritmo de duas passadas do jogo:
+    1. Verdes: letra da tentativa igual à letra da palavra-alvo na mesma posição
+    2. Amarelos: para cada posição i da tentativa (da esquerda para a direita) que
+       não é verde, consome a PRIMEIRA posição j da palavra-alvo ainda não usada
+       que tenha a mesma letra
+
+    As comparações viram máscaras (0 ou todos os bits ligados), o que permite
+    executar o mesmo código em uma candidata por vez ou em 4/8 lanes SIMD.
+*/
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define FEEDBACK_X86_GCC 1
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define FEEDBACK_HAS_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+#ifdef FEEDBACK_X86_GCC
+    #include <immintrin.h>
+#endif
+
+// Potências de 3 usadas para montar o padrão (posição i vale 3^i)
+static const uint32_t POW3[WORD_LENGTH] = { 1, 3, 9, 27, 81 };
+
+/*
+    Versão escalar: uma palavra-alvo por chamada
+    Usa máscaras em vez de if/break para seguir a mesma lógica das versões SIMD
+*/
+uint8_t feedback_pattern(uint32_t guess, uint32_t target) {
+    uint32_t g[WORD_LENGTH], t[WORD_LENGTH], green[WORD_LENGTH], used[WORD_LENGTH];
+    uint32_t pattern = 0;
+
+    // PRIMEIRA PASSADA: verdes (máscara 0xFFFFFFFF quando a letra coincide)
+    for (int i = 0; i < WORD_LENGTH; i++) {
+        g[i] = KEY_LETTER(guess, i);
+        t[i] = KEY_LETTER(target, i);
+        green[i] = 0u - (uint32_t)(g[i] == t[i]);
+        used[i] = green[i];                     // Posição verde já está consumida
+        pattern += green[i] & (2 * POW3[i]);
+    }
+
+    // SEGUNDA PASSADA: amarelos, consumindo a primeira posição livre da palavra-alvo
+    for (int i = 0; i < WORD_LENGTH; i++) {
+        uint32_t found = green[i];              // Verdes não procuram amarelo
+        for (int j = 0; j < WORD_LENGTH; j++) {
+            uint32_t m = (0u - (uint32_t)(t[j] == g[i])) & ~used[j] & ~found;
+            found |= m;
+            used[j] |= m;
+        }
+        pattern += found & ~green[i] & POW3[i];
+    }
+
+    return (uint8_t)pattern;
+}
+
+// Laço escalar usado como fallback e para o resto que não completa um vetor
+static void score_scalar(uint32_t guess, const uint32_t* candidates, size_t n, uint8_t* out) {
+    for (size_t k = 0; k < n; k++) {
+        out[k] = feedback_pattern(guess, candidates[k]);
+    }
+}
+
+#ifdef FEEDBACK_HAS_SSE2
+/*
+    Versão SSE2: 4 candidatas por iteração (uma por lane de 32 bits)
+    A tentativa é a mesma para todas as lanes, então suas letras viram constantes
+*/
+static void score_sse2(uint32_t guess, const uint32_t* candidates, size_t n, uint8_t* out) {
+    const __m128i letter_mask = _mm_set1_epi32(31);
+    __m128i g[WORD_LENGTH], pow3[WORD_LENGTH];
+    for (int i = 0; i < WORD_LENGTH; i++) {
+        g[i] = _mm_set1_epi32((int)KEY_LETTER(guess, i));
+        pow3[i] = _mm_set1_epi32((int)POW3[i]);
+    }
+
+    size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        __m128i c = _mm_loadu_si128((const __m128i*)(candidates + k));
+        __m128i t[WORD_LENGTH], green[WORD_LENGTH], used[WORD_LENGTH];
+        __m128i pattern = _mm_setzero_si128();
+
+        for (int i = 0; i < WORD_LENGTH; i++) {
+            t[i] = _mm_and_si128(_mm_srli_epi32(c, 5 * i), letter_mask);
+            green[i] = _mm_cmpeq_epi32(t[i], g[i]);
+            used[i] = green[i];
+            pattern = _mm_add_epi32(pattern, _mm_and_si128(green[i], _mm_add_epi32(pow3[i], pow3[i])));
+        }
+        for (int i = 0; i < WORD_LENGTH; i++) {
+            __m128i found = green[i];
+            for (int j = 0; j < WORD_LENGTH; j++) {
+                __m128i m = _mm_andnot_si128(found, _mm_andnot_si128(used[j], _mm_cmpeq_epi32(t[j], g[i])));
+                found = _mm_or_si128(found, m);
+                used[j] = _mm_or_si128(used[j], m);
+            }
+            pattern = _mm_add_epi32(pattern, _mm_and_si128(_mm_andnot_si128(green[i], found), pow3[i]));
+        }
+
+        // Compacta 4 x 32 bits em 4 bytes (valores cabem em 0..242)
+        __m128i packed = _mm_packs_epi32(pattern, pattern);
+        packed = _mm_packus_epi16(packed, packed);
+        uint32_t bytes = (uint32_t)_mm_cvtsi128_si32(packed);
+        out[k + 0] = (uint8_t)bytes;
+        out[k + 1] = (uint8_t)(bytes >> 8);
+        out[k + 2] = (uint8_t)(bytes >> 16);
+        out[k + 3] = (uint8_t)(bytes >> 24);
+    }
+    score_scalar(guess, candidates + k, n - k, out + k);
+}
+#endif
+
+#ifdef FEEDBACK_X86_GCC
+/*
+    Versão AVX2: 8 candidatas por iteração
+    Compilada com target("avx2") e escolhida em tempo de execução
+*/
+__attribute__((target("avx2")))
+static void score_avx2(uint32_t guess, const uint32_t* candidates, size_t n, uint8_t* out) {
+    const __m256i letter_mask = _mm256_set1_epi32(31);
+    __m256i g[WORD_LENGTH], pow3[WORD_LENGTH];
+    for (int i = 0; i < WORD_LENGTH; i++) {
+        g[i] = _mm256_set1_epi32((int)KEY_LETTER(guess, i));
+        pow3[i] = _mm256_set1_epi32((int)POW3[i]);
+    }
+
+    size_t k = 0;
+    for (; k + 8 <= n; k += 8) {
+        __m256i c = _mm256_loadu_si256((const __m256i*)(candidates + k));
+        __m256i t[WORD_LENGTH], green[WORD_LENGTH], used[WORD_LENGTH];
+        __m256i pattern = _mm256_setzero_si256();
+
+        for (int i = 0; i < WORD_LENGTH; i++) {
+            t[i] = _mm256_and_si256(_mm256_srli_epi32(c, 5 * i), letter_mask);
+            green[i] = _mm256_cmpeq_epi32(t[i], g[i]);
+            used[i] = green[i];
+            pattern = _mm256_add_epi32(pattern, _mm256_and_si256(green[i], _mm256_add_epi32(pow3[i], pow3[i])));
+        }
+        for (int i = 0; i < WORD_LENGTH; i++) {
+            __m256i found = green[i];
+            for (int j = 0; j < WORD_LENGTH; j++) {
+                __m256i m = _mm256_andnot_si256(found, _mm256_andnot_si256(used[j], _mm256_cmpeq_epi32(t[j], g[i])));
+                found = _mm256_or_si256(found, m);
+                used[j] = _mm256_or_si256(used[j], m);
+            }
+            pattern = _mm256_add_epi32(pattern, _mm256_and_si256(_mm256_andnot_si256(green[i], found), pow3[i]));
+        }
+
+        // Compacta 8 x 32 bits em 8 bytes (packs trabalham por metade de 128 bits)
+        __m128i lo = _mm256_castsi256_si128(pattern);
+        __m128i hi = _mm256_extracti128_si256(pattern, 1);
+        __m128i packed = _mm_packs_epi32(lo, hi);
+        packed = _mm_packus_epi16(packed, packed);
+        _mm_storel_epi64((__m128i*)(out + k), packed);
+    }
+    score_scalar(guess, candidates + k, n - k, out + k);
+}
+#endif
+
+/*
+    Calcula o padrão de feedback de uma tentativa contra várias candidatas
+    @param guess: Tentativa empacotada
+    @param candidates: Vetor com n palavras-alvo empacotadas
+    @param out_patterns: Saída com um padrão (0..242) por candidata
+*/
+void feedback_score(uint32_t guess, const uint32_t* candidates, size_t n, uint8_t* out_patterns) {
+    #ifdef FEEDBACK_X86_GCC
+    if (__builtin_cpu_supports("avx2")) {
+        score_avx2(guess, candidates, n, out_patterns);
+        return;
+    }
+    #endif
+    #ifdef FEEDBACK_HAS_SSE2
+    score_sse2(guess, candidates, n, out_patterns);
+    #else
+    score_scalar(guess, candidates, n, out_patterns);
+    #endif
+}
+
+/*
+    Converte um padrão base 3 no vetor de feedback por posição
+    Exemplo: 242 -> {2, 2, 2, 2, 2}
+*/
+void feedback_decode(uint8_t pattern, int out[WORD_LENGTH]) {
+    unsigned p = pattern;
+    for (int i = 0; i < WORD_LENGTH; i++) {
+        out[i] = (int)(p % 3);
+        p /= 3;
+    }
+}
+
+/*
+    Converte o vetor de feedback por posição no padrão base 3
+    Exemplo: {2, 2, 2, 2, 2} -> 242
+*/
+uint8_t feedback_encode(const int feedback[WORD_LENGTH]) {
+    uint32_t pattern = 0;
+    for (int i = 0; i < WORD_LENGTH; i++) {
+        pattern += (uint32_t)feedback[i] * POW3[i];
+    }
+    return (uint8_t)pattern;
+}
+
+const char* feedback_kernel_name(void) {
+    #ifdef FEEDBACK_X86_GCC
+    if (__builtin_cpu_supports("avx2")) return "avx2";
+    #endif
+    #ifdef FEEDBACK_HAS_SSE2
+    return "sse2";
+    #else
+    return "escalar";
+    #endif
+}
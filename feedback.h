@@ -0,0 +1,30 @@
+#ifndef FEEDBACK_H
+#define FEEDBACK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "palavra.h"
+
+/*
+    Padrão de feedback compacto em base 3: a posição i contribui com
+    feedback[i] * 3^i (0=cinza, 1=amarelo, 2=verde). Cabe em um byte (0..242).
+*/
+#define FEEDBACK_PATTERNS 243   // 3^5 padrões possíveis
+#define PATTERN_ALL_GREEN 242   // Todas as letras na posição correta (vitória)
+
+// Calcula o padrão de feedback de uma tentativa contra uma palavra-alvo
+uint8_t feedback_pattern(uint32_t guess, uint32_t target);
+
+// Calcula o padrão de uma tentativa contra n candidatas (SIMD quando disponível)
+void feedback_score(uint32_t guess, const uint32_t* candidates, size_t n, uint8_t* out_patterns);
+
+// Converte o vetor por posição (0, 1 ou 2) em um padrão base 3
+uint8_t feedback_encode(const int feedback[WORD_LENGTH]);
+
+// Converte um padrão base 3 de volta para o vetor por posição (0, 1 ou 2)
+void feedback_decode(uint8_t pattern, int out[WORD_LENGTH]);
+
+// Nome do kernel usado por feedback_score nesta máquina ("avx2", "sse2" ou "escalar")
+const char* feedback_kernel_name(void);
+
+#endif
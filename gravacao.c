@@ -0,0 +1,369 @@
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gravacao.h"
+#include "pool.h"
+#include "relogio.h"
+#include "salvamento.h"
+
+#define GRAVACAO_BUFFER (64 * 1024)         // Buffer do log (eventos são pequenos)
+#define GRAVACAO_MAX_EVENTO 192             // Maior evento codificado (RETOMADA)
+#define GRAVACAO_MAX_SESSAO (1ull << 32)    // Limite de sanidade do número da sessão
+
+static const char GRAVACAO_MAGIC[8] = { 'C', 'O', 'D', 'L', 'E', 'C', 'G', 'R' };
+#define GRAVACAO_CABECALHO (sizeof(GRAVACAO_MAGIC) + sizeof(uint32_t))
+
+// Evento sendo codificado (um fwrite por evento)
+typedef struct {
+    unsigned char b[GRAVACAO_MAX_EVENTO];
+    size_t n;
+} Evento;
+
+static void por_varint(Evento* e, uint64_t v) {
+    while (v >= 0x80) {
+        e->b[e->n++] = (unsigned char)(v | 0x80);
+        v >>= 7;
+    }
+    e->b[e->n++] = (unsigned char)v;
+}
+
+static void iniciar_evento(Evento* e, TipoEvento tipo, uint64_t sessao) {
+    e->n = 0;
+    e->b[e->n++] = (unsigned char)tipo;
+    por_varint(e, sessao);
+}
+
+static void emitir(Gravacao* g, const Evento* e) {
+    if (fwrite(e->b, 1, e->n, g->f) != e->n) return;
+    g->eventos++;
+    g->bytes += e->n;
+}
+
+int gravacao_abrir(Gravacao* g, const char* caminho) {
+    memset(g, 0, sizeof(*g));
+    g->f = fopen(caminho, "wb");
+    if (!g->f) return 0;
+    setvbuf(g->f, NULL, _IOFBF, GRAVACAO_BUFFER);
+    uint32_t versao = GRAVACAO_VERSAO;
+    if (fwrite(GRAVACAO_MAGIC, sizeof(GRAVACAO_MAGIC), 1, g->f) != 1 ||
+        fwrite(&versao, sizeof(versao), 1, g->f) != 1) {
+        fclose(g->f);
+        g->f = NULL;
+        return 0;
+    }
+    g->bytes = GRAVACAO_CABECALHO;
+    return 1;
+}
+
+void gravacao_fechar(Gravacao* g) {
+    if (!g->f) return;
+    fclose(g->f);
+    g->f = NULL;
+}
+
+void gravacao_nova(Gravacao* g, uint64_t sessao, uint64_t semente, const GameState* game) {
+    if (!g || !g->f) return;
+    Evento e;
+    iniciar_evento(&e, EVENTO_NOVA, sessao);
+    por_varint(&e, semente);
+    por_varint(&e, game->difficulty);
+    por_varint(&e, game->letras);
+    por_varint(&e, game->target);
+    emitir(g, &e);
+}
+
+void gravacao_retomada(Gravacao* g, uint64_t sessao, const GameState* game) {
+    if (!g || !g->f) return;
+    Evento e;
+    PartidaSalva p;
+    salvamento_codificar(game, sessao, &p);
+    iniciar_evento(&e, EVENTO_RETOMADA, sessao);
+    memcpy(e.b + e.n, &p, sizeof(p));
+    e.n += sizeof(p);
+    emitir(g, &e);
+}
+
+void gravacao_tentativa(Gravacao* g, uint64_t sessao, const GameState* game, const char* palavra, int aceita) {
+    if (!g || !g->f) return;
+    uint64_t chave = strlen(palavra) == (size_t)game->letras ? game->comprimento->empacotar(palavra) : 0;
+    Evento e;
+    iniciar_evento(&e, EVENTO_TENTATIVA, sessao);
+    por_varint(&e, chave);
+    por_varint(&e, aceita ? 1 : 0);
+    if (aceita) por_varint(&e, game->padroes[game->current_attempt - 1]);
+    emitir(g, &e);
+}
+
+void gravacao_dica(Gravacao* g, uint64_t sessao, time_t agora, int resultado) {
+    if (!g || !g->f) return;
+    Evento e;
+    iniciar_evento(&e, EVENTO_DICA, sessao);
+    por_varint(&e, (uint64_t)agora);
+    por_varint(&e, (uint64_t)(resultado - GRAVACAO_DICA_SEM_POSICAO));  // -2.. -> 0..
+    emitir(g, &e);
+}
+
+void gravacao_fim(Gravacao* g, uint64_t sessao, const GameState* game, MotivoFim motivo) {
+    if (!g || !g->f) return;
+    Evento e;
+    iniciar_evento(&e, EVENTO_FIM, sessao);
+    por_varint(&e, motivo);
+    por_varint(&e, game->won);
+    por_varint(&e, game->current_attempt);
+    emitir(g, &e);
+}
+
+unsigned char* gravacao_carregar(const char* caminho, size_t* tamanho) {
+    FILE* f = fopen(caminho, "rb");
+    if (!f) return NULL;
+    unsigned char* dados = NULL;
+    size_t n = 0, capacidade = 0;
+    for (;;) {
+        if (n == capacidade) {
+            capacidade = capacidade ? capacidade * 2 : (1 << 20);
+            unsigned char* novo = realloc(dados, capacidade);
+            if (!novo) {
+                free(dados);
+                fclose(f);
+                return NULL;
+            }
+            dados = novo;
+        }
+        size_t lidos = fread(dados + n, 1, capacidade - n, f);
+        if (lidos == 0) break;
+        n += lidos;
+    }
+    fclose(f);
+
+    uint32_t versao;
+    if (n < GRAVACAO_CABECALHO || memcmp(dados, GRAVACAO_MAGIC, sizeof(GRAVACAO_MAGIC)) != 0 ||
+        (memcpy(&versao, dados + sizeof(GRAVACAO_MAGIC), sizeof(versao)), versao != GRAVACAO_VERSAO)) {
+        free(dados);
+        return NULL;
+    }
+    *tamanho = n;
+    return dados;
+}
+
+// Lê um varint; 0 se o evento acaba antes (log cortado) ou o valor não cabe em 64 bits
+static int ler_varint(const unsigned char** p, const unsigned char* fim, uint64_t* v) {
+    uint64_t valor = 0;
+    for (int desloc = 0; desloc < 64; desloc += 7) {
+        if (*p >= fim) return 0;
+        unsigned char b = *(*p)++;
+        valor |= (uint64_t)(b & 0x7F) << desloc;
+        if (!(b & 0x80)) {
+            *v = valor;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Partidas em andamento na repetição, pelo número da sessão
+typedef struct {
+    GameState** sessoes;
+    size_t capacidade;
+    Pool pool;
+} Mesa;
+
+static GameState** lugar_da_sessao(Mesa* m, uint64_t sessao) {
+    if (sessao >= GRAVACAO_MAX_SESSAO) return NULL;
+    if (sessao >= m->capacidade) {
+        size_t nova = m->capacidade ? m->capacidade : 64;
+        while (nova <= sessao) nova *= 2;
+        GameState** vetor = realloc(m->sessoes, nova * sizeof(GameState*));
+        if (!vetor) return NULL;
+        memset(vetor + m->capacidade, 0, (nova - m->capacidade) * sizeof(GameState*));
+        m->sessoes = vetor;
+        m->capacidade = nova;
+    }
+    return &m->sessoes[sessao];
+}
+
+// Partida da sessão, criada na primeira vez
+static GameState* abrir_sessao(Mesa* m, uint64_t sessao) {
+    GameState** lugar = lugar_da_sessao(m, sessao);
+    if (!lugar) return NULL;
+    if (!*lugar) *lugar = pool_obter(&m->pool);
+    return *lugar;
+}
+
+static void fechar_sessao_mesa(Mesa* m, uint64_t sessao) {
+    if (sessao >= m->capacidade || !m->sessoes[sessao]) return;
+    pool_devolver(&m->pool, m->sessoes[sessao]);
+    m->sessoes[sessao] = NULL;
+}
+
+// Partida já aberta da sessão, ou NULL
+static GameState* sessao_aberta(Mesa* m, uint64_t sessao) {
+    return sessao < m->capacidade ? m->sessoes[sessao] : NULL;
+}
+
+// Conta (e descreve as primeiras) divergências entre o gravado e o refeito
+static void divergir(Reproducao* r, int detalhar, uint64_t sessao, const char* formato, ...)
+    __attribute__((format(printf, 4, 5)));
+static void divergir(Reproducao* r, int detalhar, uint64_t sessao, const char* formato, ...) {
+    if (r->divergencias++ >= (uint64_t)detalhar) return;
+    printf("Divergência no evento %llu (sessão %llu): ", (unsigned long long)r->eventos,
+           (unsigned long long)sessao);
+    va_list args;
+    va_start(args, formato);
+    vprintf(formato, args);
+    va_end(args);
+    printf("\n");
+}
+
+int gravacao_reproduzir(const Motor* motor, const unsigned char* dados, size_t tamanho,
+                        Reproducao* r, int detalhar) {
+    Mesa mesa;
+    memset(&mesa, 0, sizeof(mesa));
+    pool_iniciar(&mesa.pool, sizeof(GameState), 0);
+
+    const unsigned char* p = dados + GRAVACAO_CABECALHO;
+    const unsigned char* fim = dados + tamanho;
+    int completo = 1;
+    while (p < fim) {
+        const unsigned char* inicio = p;
+        unsigned tipo = *p++;
+        uint64_t sessao, a = 0, b = 0, c = 0, d = 0;
+        int ok = ler_varint(&p, fim, &sessao);
+        switch (tipo) {
+            case EVENTO_NOVA:
+                ok = ok && ler_varint(&p, fim, &a) && ler_varint(&p, fim, &b) &&
+                     ler_varint(&p, fim, &c) && ler_varint(&p, fim, &d);
+                break;
+            case EVENTO_RETOMADA:
+                ok = ok && (size_t)(fim - p) >= sizeof(PartidaSalva);
+                break;
+            case EVENTO_TENTATIVA:
+                ok = ok && ler_varint(&p, fim, &a) && ler_varint(&p, fim, &b) && (!b || ler_varint(&p, fim, &c));
+                break;
+            case EVENTO_DICA:
+            case EVENTO_FIM:
+                ok = ok && ler_varint(&p, fim, &a) && ler_varint(&p, fim, &b);
+                if (tipo == EVENTO_FIM) ok = ok && ler_varint(&p, fim, &c);
+                break;
+            default:
+                ok = 0;
+        }
+        if (!ok) {
+            // Evento incompleto no final (gravação interrompida) ou log inválido
+            r->cortados += (uint64_t)(fim - inicio);
+            completo = tipo >= EVENTO_NOVA && tipo <= EVENTO_FIM;
+            break;
+        }
+        r->eventos++;
+
+        GameState* game;
+        uint64_t t0 = agora_nanossegundos();
+        switch (tipo) {
+            case EVENTO_NOVA:
+                game = abrir_sessao(&mesa, sessao);
+                if (!game || !init_game_letras(game, motor, (Difficulty)b, (int)c, a)) {
+                    divergir(r, detalhar, sessao, "partida de %d letras não pôde ser criada", (int)c);
+                    fechar_sessao_mesa(&mesa, sessao);
+                    break;
+                }
+                r->ns_nova += agora_nanossegundos() - t0;
+                r->partidas++;
+                if (game->target != d) {
+                    divergir(r, detalhar, sessao, "palavra sorteada %llx, refeita %llx",
+                             (unsigned long long)d, (unsigned long long)game->target);
+                }
+                break;
+
+            case EVENTO_RETOMADA: {
+                PartidaSalva salva;
+                memcpy(&salva, p, sizeof(salva));
+                p += sizeof(salva);
+                game = abrir_sessao(&mesa, sessao);
+                if (!game || !salvamento_restaurar(&salva, motor, game)) {
+                    divergir(r, detalhar, sessao, "partida retomada inválida");
+                    fechar_sessao_mesa(&mesa, sessao);
+                    break;
+                }
+                r->ns_nova += agora_nanossegundos() - t0;
+                r->partidas++;
+                break;
+            }
+
+            case EVENTO_TENTATIVA: {
+                game = sessao_aberta(&mesa, sessao);
+                if (!game) {
+                    // Sessão fechada, nunca aberta ou cuja partida não pôde ser refeita
+                    divergir(r, detalhar, sessao, "tentativa sem partida aberta");
+                    break;
+                }
+                int aceita = 0;
+                char texto[PALAVRA_MAX + 1];
+                if (a != 0) {
+                    for (int i = 0; i < game->letras; i++) texto[i] = KEY_CHAR(a, i);
+                    texto[game->letras] = '\0';
+                    aceita = !game->game_over && check_word_exists(game, texto);
+                }
+                uint64_t t1 = agora_nanossegundos();
+                r->ns_validacao += t1 - t0;
+                if (aceita != (int)b) {
+                    // Segue o gravado: a partida só avança quando os dois aceitaram
+                    divergir(r, detalhar, sessao, "tentativa %s aceita=%d, refeita aceita=%d",
+                             a ? texto : "-", (int)b, aceita);
+                    break;
+                }
+                if (!aceita) {
+                    r->rejeitadas++;
+                    break;
+                }
+                process_guess(game, texto);
+                r->ns_tentativa += agora_nanossegundos() - t1;
+                r->tentativas++;
+                if (game->padroes[game->current_attempt - 1] != c) {
+                    divergir(r, detalhar, sessao, "tentativa %s com padrão %d, refeito %d", texto,
+                             (int)c, (int)game->padroes[game->current_attempt - 1]);
+                }
+                break;
+            }
+
+            case EVENTO_DICA: {
+                game = sessao_aberta(&mesa, sessao);
+                if (!game) {
+                    divergir(r, detalhar, sessao, "dica sem partida aberta");
+                    break;
+                }
+                int esperado = (int)b + GRAVACAO_DICA_SEM_POSICAO;
+                int resultado = GRAVACAO_DICA_INDISPONIVEL;
+                if (can_use_hint(game, (time_t)a)) {
+                    resultado = use_hint(game, (time_t)a);
+                    if (resultado < 0) resultado = GRAVACAO_DICA_SEM_POSICAO;
+                }
+                r->ns_dica += agora_nanossegundos() - t0;
+                r->dicas++;
+                if (resultado != esperado) {
+                    divergir(r, detalhar, sessao, "dica %d, refeita %d", esperado, resultado);
+                }
+                break;
+            }
+
+            case EVENTO_FIM:
+                game = sessao_aberta(&mesa, sessao);
+                if (!game) {
+                    divergir(r, detalhar, sessao, "fim sem partida aberta");
+                    break;
+                }
+                if (a == FIM_ENCERRADA) {
+                    if (!game->game_over || game->won != b || game->current_attempt != c) {
+                        divergir(r, detalhar, sessao, "fim com vitória=%d em %d tentativa(s), refeito vitória=%d em %d",
+                                 (int)b, (int)c, (int)game->won, (int)game->current_attempt);
+                    }
+                    if (game->won) r->vitorias++;
+                }
+                fechar_sessao_mesa(&mesa, sessao);
+                break;
+        }
+    }
+
+    free(mesa.sessoes);
+    pool_liberar(&mesa.pool);
+    return completo;
+}
@@ -0,0 +1,101 @@
+#ifndef GRAVACAO_H
+#define GRAVACAO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "motor.h"
+
+/*
+    Gravação e repetição de partidas
+
+    O jogo no terminal e o servidor podem gravar tudo o que chega ao motor
+    em um log binário de eventos: partida nova (semente e palavra sorteada),
+    partida retomada (estado salvo), tentativa (palavra, aceita ou não, e o
+    feedback), pedido de dica (horário e posição revelada) e fim (motivo,
+    vitória e tentativas). A edição da linha no terminal (letras apagadas,
+    redesenhos) não chega ao motor e não é gravada.
+
+    A repetição roda o log sem terminal, na velocidade máxima, contra o
+    motor atual: cada evento é refeito e o resultado é comparado com o
+    gravado (palavra sorteada, aceitação, padrão de feedback, dica, fim).
+    Serve como benchmark realista e como teste de regressão do motor.
+
+    Formato: cabeçalho ("CODLECGR" + versão) e eventos em sequência; cada
+    evento é um byte de tipo seguido de campos em varint (LEB128). A
+    sessão identifica a partida no servidor (0 no terminal). Um evento
+    cortado no final (queda durante a gravação) é ignorado.
+*/
+
+#define GRAVACAO_VERSAO 1
+
+// Tipos de evento
+typedef enum {
+    EVENTO_NOVA = 1,        // sessao, semente, dificuldade, letras, alvo
+    EVENTO_RETOMADA = 2,    // sessao, PartidaSalva (estado completo)
+    EVENTO_TENTATIVA = 3,   // sessao, chave (0 = palavra impossível de empacotar), aceita, padrão
+    EVENTO_DICA = 4,        // sessao, horário, resultado (posição, GRAVACAO_DICA_*)
+    EVENTO_FIM = 5          // sessao, motivo, venceu, tentativas
+} TipoEvento;
+
+// Resultado de um pedido de dica que não revelou letra
+#define GRAVACAO_DICA_INDISPONIVEL (-1)     // can_use_hint recusou (limite ou intervalo)
+#define GRAVACAO_DICA_SEM_POSICAO (-2)      // use_hint não achou posição livre
+
+// Motivo do fim de uma partida
+typedef enum {
+    FIM_ENCERRADA = 0,      // Vitória ou derrota
+    FIM_ABANDONADA = 1,     // Desistência, reinício, conexão fechada
+    FIM_SALVA = 2           // Salva para continuar depois
+} MotivoFim;
+
+typedef struct {
+    FILE* f;                // NULL = gravação desligada (as funções não fazem nada)
+    uint64_t eventos;
+    uint64_t bytes;
+} Gravacao;
+
+// Cria o log (substitui um anterior); 1 se está gravando
+int gravacao_abrir(Gravacao* g, const char* caminho);
+void gravacao_fechar(Gravacao* g);
+
+// Eventos (chamados depois da operação no motor, com o estado já atualizado)
+void gravacao_nova(Gravacao* g, uint64_t sessao, uint64_t semente, const GameState* game);
+void gravacao_retomada(Gravacao* g, uint64_t sessao, const GameState* game);
+void gravacao_tentativa(Gravacao* g, uint64_t sessao, const GameState* game, const char* palavra, int aceita);
+void gravacao_dica(Gravacao* g, uint64_t sessao, time_t agora, int resultado);
+void gravacao_fim(Gravacao* g, uint64_t sessao, const GameState* game, MotivoFim motivo);
+
+// Totais de uma repetição
+typedef struct {
+    uint64_t eventos;
+    uint64_t partidas;              // NOVA + RETOMADA
+    uint64_t tentativas;            // Aceitas (process_guess)
+    uint64_t rejeitadas;            // Recusadas pela validação
+    uint64_t dicas;
+    uint64_t vitorias;
+    uint64_t divergencias;          // Eventos com resultado diferente do gravado ou sem partida aberta
+    uint64_t cortados;              // Bytes finais ignorados (evento incompleto)
+    uint64_t ns_nova;               // Tempo em cada fase (nanossegundos somados)
+    uint64_t ns_validacao;
+    uint64_t ns_tentativa;
+    uint64_t ns_dica;
+} Reproducao;
+
+/*
+    Lê um log inteiro para a memória
+    @return: Dados (liberar com free) ou NULL se o arquivo não existe ou não é um log
+*/
+unsigned char* gravacao_carregar(const char* caminho, size_t* tamanho);
+
+/*
+    Repete os eventos de um log contra o motor, somando em `r`
+    @param detalhar: Quantas divergências descrever em stdout (0 = nenhuma)
+    @return: 1 se o log foi lido até o fim (divergências não contam como erro)
+*/
+int gravacao_reproduzir(const Motor* motor, const unsigned char* dados, size_t tamanho,
+                        Reproducao* r, int detalhar);
+
+#endif
@@ -0,0 +1,336 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lote.h"
+#include "relogio.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+    typedef CRITICAL_SECTION Trava;
+    #define trava_iniciar(t)   InitializeCriticalSection(t)
+    #define trava_destruir(t)  DeleteCriticalSection(t)
+    #define travar(t)          EnterCriticalSection(t)
+    #define destravar(t)       LeaveCriticalSection(t)
+#else
+    #include <pthread.h>
+    typedef pthread_mutex_t Trava;
+    #define trava_iniciar(t)   pthread_mutex_init(t, NULL)
+    #define trava_destruir(t)  pthread_mutex_destroy(t)
+    #define travar(t)          pthread_mutex_lock(t)
+    #define destravar(t)       pthread_mutex_unlock(t)
+#endif
+
+/*
+    Fila de trabalho de uma thread: faixa [ini, fim) de jogos ainda não jogados
+    A dona consome pelo início; quem rouba leva a metade final da faixa
+*/
+typedef struct {
+    Trava trava;
+    uint32_t ini, fim;
+    uint32_t roubos;            // Roubos feitos POR esta thread
+} LoteFila;
+
+// Contexto de uma thread trabalhadora
+typedef struct {
+    Lote* lote;
+    LoteFila* filas;
+    int n_filas;
+    int id;
+} LoteTrabalhador;
+
+void lote_iniciar(Lote* lote, ResolverBase* base) {
+    memset(lote, 0, sizeof(*lote));
+    lote->base = base;
+}
+
+int lote_adicionar_modo(Lote* lote, const LoteModo* modo) {
+    if (lote->n_modos >= LOTE_MAX_MODOS || modo->max_tentativas > LOTE_MAX_TENTATIVAS) return 0;
+    lote->modos[lote->n_modos++] = *modo;
+    return 1;
+}
+
+/*
+    Pega o próximo jogo para a thread `id`
+    1. Da própria fila, pelo início
+    2. Se vazia, rouba a metade final da fila com mais trabalho restante
+    @return: 1 se obteve um jogo em *jogo, 0 se não há mais trabalho
+*/
+static int pegar_jogo(LoteTrabalhador* t, uint32_t* jogo) {
+    LoteFila* minha = &t->filas[t->id];
+
+    travar(&minha->trava);
+    if (minha->ini < minha->fim) {
+        *jogo = minha->ini++;
+        destravar(&minha->trava);
+        return 1;
+    }
+    destravar(&minha->trava);
+
+    while (1) {
+        // Escolhe a vítima com mais jogos restantes
+        int vitima = -1;
+        uint32_t maior = 0;
+        for (int v = 0; v < t->n_filas; v++) {
+            if (v == t->id) continue;
+            travar(&t->filas[v].trava);
+            uint32_t restantes = t->filas[v].fim - t->filas[v].ini;
+            destravar(&t->filas[v].trava);
+            if (restantes > maior) {
+                maior = restantes;
+                vitima = v;
+            }
+        }
+        if (vitima < 0) return 0;               // Todas as filas vazias: fim do lote
+
+        LoteFila* outra = &t->filas[vitima];
+        travar(&outra->trava);
+        uint32_t restantes = outra->fim - outra->ini;
+        if (restantes == 0) {                   // Esvaziou enquanto escolhíamos: tenta outra
+            destravar(&outra->trava);
+            continue;
+        }
+        uint32_t levar = (restantes + 1) / 2;
+        uint32_t inicio = outra->fim - levar;
+        outra->fim = inicio;
+        destravar(&outra->trava);
+
+        travar(&minha->trava);
+        minha->ini = inicio + 1;
+        minha->fim = inicio + levar;
+        minha->roubos++;
+        destravar(&minha->trava);
+        *jogo = inicio;
+        return 1;
+    }
+}
+
+/*
+    Joga uma partida completa com as regras do modo
+    O padrão de cada tentativa vem da tabela (se houver) ou do kernel de feedback
+*/
+static void jogar(Lote* lote, Resolver* r, LoteResultado* res) {
+    const LoteModo* modo = &lote->modos[res->modo];
+    const ResolverBase* base = lote->base;
+
+    res->tentativas = 0;
+    res->venceu = 0;
+    for (int t = 0; t < modo->max_tentativas; t++) {
+        uint32_t palpite = resolver_escolher(r, modo->max_tentativas - t);
+        if (palpite == RESOLVER_NENHUM) break;
+
+        uint8_t padrao = base->tabela
+            ? TABELA_PADRAO(base->tabela, palpite, res->alvo)
+            : feedback_pattern(base->palavras[palpite], base->palavras[res->alvo]);
+
+        res->palpites[t] = palpite;
+        res->tentativas = (uint8_t)(t + 1);
+        if (padrao == PATTERN_ALL_GREEN) {
+            res->venceu = 1;
+            break;
+        }
+        resolver_filtrar(r, palpite, padrao);
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI trabalhar(LPVOID arg) {
+#else
+static void* trabalhar(void* arg) {
+#endif
+    LoteTrabalhador* t = arg;
+    Lote* lote = t->lote;
+    Resolver resolvedores[LOTE_MAX_MODOS];      // Um por modo, reaproveitado entre jogos
+    int prontos[LOTE_MAX_MODOS] = { 0 };
+    uint32_t jogo;
+
+    while (pegar_jogo(t, &jogo)) {
+        LoteResultado* res = &lote->resultados[jogo];
+        const LoteModo* modo = &lote->modos[res->modo];
+        Resolver* r = &resolvedores[res->modo];
+
+        if (!prontos[res->modo]) {
+            if (!resolver_iniciar(r, lote->base, modo->cand_ini, modo->cand_fim, modo->palp_ini, modo->palp_fim)) {
+                continue;                       // Sem memória: jogo fica com 0 tentativas
+            }
+            prontos[res->modo] = 1;
+        } else {
+            resolver_reiniciar(r);
+        }
+        jogar(lote, r, res);
+    }
+
+    for (int m = 0; m < lote->n_modos; m++) {
+        if (prontos[m]) resolver_liberar(&resolvedores[m]);
+    }
+    return 0;
+}
+
+/*
+    Executa todos os jogos do lote
+    Abertura e segundos palpites são calculados antes das threads, deixando a
+    base somente leitura; cada thread escreve apenas nos seus resultados
+    @return: 1 em caso de sucesso, 0 se faltar memória
+*/
+int lote_executar(Lote* lote, int threads) {
+    uint32_t total = 0;
+    for (int m = 0; m < lote->n_modos; m++) {
+        const LoteModo* modo = &lote->modos[m];
+        if (!resolver_preparar(lote->base, modo->cand_ini, modo->cand_fim, modo->palp_ini, modo->palp_fim)) {
+            return 0;
+        }
+        total += modo->cand_fim - modo->cand_ini;
+    }
+
+    free(lote->resultados);
+    lote->resultados = calloc((size_t)total + 1, sizeof(LoteResultado));
+    if (!lote->resultados) return 0;
+    lote->n_jogos = 0;
+    for (int m = 0; m < lote->n_modos; m++) {
+        for (uint32_t a = lote->modos[m].cand_ini; a < lote->modos[m].cand_fim; a++) {
+            lote->resultados[lote->n_jogos].modo = (uint8_t)m;
+            lote->resultados[lote->n_jogos].alvo = a;
+            lote->n_jogos++;
+        }
+    }
+
+    if (threads < 1) threads = 1;
+    if ((uint32_t)threads > total && total > 0) threads = (int)total;
+
+    LoteFila* filas = calloc((size_t)threads, sizeof(LoteFila));
+    LoteTrabalhador* trabalhadores = calloc((size_t)threads, sizeof(LoteTrabalhador));
+    #ifdef _WIN32
+    HANDLE* ids = calloc((size_t)threads, sizeof(HANDLE));
+    #else
+    pthread_t* ids = calloc((size_t)threads, sizeof(pthread_t));
+    #endif
+    if (!filas || !trabalhadores || !ids) {
+        free(filas);
+        free(trabalhadores);
+        free(ids);
+        return 0;
+    }
+
+    // Distribuição inicial em blocos contíguos; o roubo corrige desequilíbrios
+    uint32_t passo = (total + (uint32_t)threads - 1) / (uint32_t)threads;
+    for (int i = 0; i < threads; i++) {
+        trava_iniciar(&filas[i].trava);
+        filas[i].ini = (uint32_t)i * passo < total ? (uint32_t)i * passo : total;
+        filas[i].fim = filas[i].ini + passo < total ? filas[i].ini + passo : total;
+        trabalhadores[i].lote = lote;
+        trabalhadores[i].filas = filas;
+        trabalhadores[i].n_filas = threads;
+        trabalhadores[i].id = i;
+    }
+
+    double inicio = agora_segundos();
+    int iniciadas = 0;
+    for (int i = 1; i < threads; i++) {
+        #ifdef _WIN32
+        ids[i] = CreateThread(NULL, 0, trabalhar, &trabalhadores[i], 0, NULL);
+        if (!ids[i]) break;
+        #else
+        if (pthread_create(&ids[i], NULL, trabalhar, &trabalhadores[i]) != 0) break;
+        #endif
+        iniciadas = i;
+    }
+    trabalhar(&trabalhadores[0]);               // A thread atual também trabalha (e rouba das que faltaram)
+    for (int i = 1; i <= iniciadas; i++) {
+        #ifdef _WIN32
+        WaitForSingleObject(ids[i], INFINITE);
+        CloseHandle(ids[i]);
+        #else
+        pthread_join(ids[i], NULL);
+        #endif
+    }
+    lote->segundos = agora_segundos() - inicio;
+
+    lote->threads = iniciadas + 1;
+    lote->roubos = 0;
+    for (int i = 0; i < threads; i++) {
+        lote->roubos += filas[i].roubos;
+        trava_destruir(&filas[i].trava);
+    }
+    free(filas);
+    free(trabalhadores);
+    free(ids);
+    return 1;
+}
+
+// Escreve uma palavra empacotada em minúsculas
+static void escrever_palavra(FILE* file, uint32_t chave) {
+    for (int i = 0; i < WORD_LENGTH; i++) {
+        fputc(KEY_CHAR(chave, i) - 'A' + 'a', file);
+    }
+}
+
+/*
+    Relatório por palavra em CSV
+    Colunas: modo, palavra, tentativas, resultado, abertura, palpites
+*/
+int lote_gravar_relatorio(const Lote* lote, const char* caminho) {
+    FILE* file = fopen(caminho, "w");
+    if (!file) return 0;
+
+    const uint32_t* palavras = lote->base->palavras;
+    fprintf(file, "modo,palavra,tentativas,resultado,abertura,palpites\n");
+    for (uint32_t j = 0; j < lote->n_jogos; j++) {
+        const LoteResultado* res = &lote->resultados[j];
+        fprintf(file, "%s,", lote->modos[res->modo].nome);
+        escrever_palavra(file, palavras[res->alvo]);
+        fprintf(file, ",%d,%s,", res->tentativas, res->venceu ? "sucesso" : "falha");
+        if (res->tentativas > 0) escrever_palavra(file, palavras[res->palpites[0]]);
+        fputc(',', file);
+        for (int t = 0; t < res->tentativas; t++) {
+            if (t > 0) fputc(' ', file);
+            escrever_palavra(file, palavras[res->palpites[t]]);
+        }
+        fputc('\n', file);
+    }
+    return fclose(file) == 0;
+}
+
+/*
+    Resumo no terminal: distribuição de tentativas por modo, taxa de sucesso
+    e média de tentativas nas vitórias
+*/
+void lote_imprimir_resumo(const Lote* lote) {
+    for (int m = 0; m < lote->n_modos; m++) {
+        const LoteModo* modo = &lote->modos[m];
+        uint32_t hist[LOTE_MAX_TENTATIVAS + 1] = { 0 };
+        uint32_t jogos = 0, vitorias = 0, soma = 0;
+        uint32_t abertura = RESOLVER_NENHUM;
+
+        for (uint32_t j = 0; j < lote->n_jogos; j++) {
+            const LoteResultado* res = &lote->resultados[j];
+            if (res->modo != m) continue;
+            jogos++;
+            if (res->tentativas > 0) abertura = res->palpites[0];
+            if (res->venceu) {
+                vitorias++;
+                soma += res->tentativas;
+                hist[res->tentativas]++;
+            }
+        }
+
+        printf("\n%s (%d tentativas): %u jogos, abertura ", modo->nome, modo->max_tentativas, jogos);
+        if (abertura != RESOLVER_NENHUM) escrever_palavra(stdout, lote->base->palavras[abertura]);
+        printf("\n");
+        for (int t = 1; t <= modo->max_tentativas; t++) {
+            printf("  %d: %7u (%5.1f%%)\n", t, hist[t], jogos ? 100.0 * hist[t] / jogos : 0.0);
+        }
+        printf("  X: %7u (%5.1f%%)\n", jogos - vitorias, jogos ? 100.0 * (jogos - vitorias) / jogos : 0.0);
+        printf("  Sucesso: %.2f%% | Média de tentativas nas vitórias: %.3f\n",
+               jogos ? 100.0 * vitorias / jogos : 0.0, vitorias ? (double)soma / vitorias : 0.0);
+    }
+
+    printf("\n%u jogos em %.2fs (%.0f jogos/s) com %d thread(s), %u roubo(s) de trabalho\n",
+           lote->n_jogos, lote->segundos,
+           lote->segundos > 0 ? lote->n_jogos / lote->segundos : 0.0, lote->threads, lote->roubos);
+}
+
+void lote_liberar(Lote* lote) {
+    free(lote->resultados);
+    lote->resultados = NULL;
+    lote->n_jogos = 0;
+}
@@ -0,0 +1,57 @@
+#ifndef LOTE_H
+#define LOTE_H
+
+#include <stdint.h>
+#include "resolver.h"
+
+/*
+    Avaliação em lote: o resolvedor joga uma partida completa contra cada
+    palavra-alvo de cada modo, distribuindo os jogos entre várias threads
+    com roubo de trabalho (work stealing)
+*/
+
+#define LOTE_MAX_MODOS 4         // Modos avaliados em uma mesma execução
+#define LOTE_MAX_TENTATIVAS 8    // Limite de tentativas suportado no relatório
+
+// Regras de um modo de jogo (equivalente a uma dificuldade do jogo)
+typedef struct {
+    const char* nome;           // Nome exibido no relatório ("FÁCIL", ...)
+    int max_tentativas;         // Mesmo limite usado por init_game
+    uint32_t cand_ini, cand_fim; // Palavras-alvo do modo (índices em base->palavras)
+    uint32_t palp_ini, palp_fim; // Palavras aceitas como tentativa
+} LoteModo;
+
+// Resultado de um jogo
+typedef struct {
+    uint8_t modo;                               // Índice em Lote.modos
+    uint8_t tentativas;                         // Tentativas usadas
+    uint8_t venceu;                             // 1 = acertou dentro do limite
+    uint32_t alvo;                              // Índice da palavra-alvo
+    uint32_t palpites[LOTE_MAX_TENTATIVAS];     // Sequência de palpites
+} LoteResultado;
+
+typedef struct {
+    ResolverBase* base;
+    LoteModo modos[LOTE_MAX_MODOS];
+    int n_modos;
+    LoteResultado* resultados;  // Um por jogo, na ordem modo/alvo
+    uint32_t n_jogos;
+    int threads;                // Threads efetivamente usadas
+    uint32_t roubos;            // Quantas vezes uma thread roubou trabalho de outra
+    double segundos;            // Tempo total dos jogos (sem a preparação)
+} Lote;
+
+// Prepara o lote; adicione os modos com lote_adicionar_modo antes de executar
+void lote_iniciar(Lote* lote, ResolverBase* base);
+int lote_adicionar_modo(Lote* lote, const LoteModo* modo);
+
+// Joga todas as partidas com `threads` threads
+int lote_executar(Lote* lote, int threads);
+
+// Relatório por palavra em CSV e resumo das distribuições no terminal
+int lote_gravar_relatorio(const Lote* lote, const char* caminho);
+void lote_imprimir_resumo(const Lote* lote);
+
+void lote_liberar(Lote* lote);
+
+#endif
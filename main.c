@@ -3,6 +3,24 @@
 #include <string.h>
 #include <ctype.h>
 #include <time.h>
+#include <stdint.h>
+
+#include "palavra.h"    // Representação empacotada das palavras
+#include "motor.h"      // Motor do jogo (dicionário, partida, dicas)
+#include "feedback.h"   // Kernel de feedback (escalar/SSE2/AVX2)
+#include "tabela.h"     // Tabela pré-computada de padrões (cache mmap)
+#include "resolver.h"   // Resolvedor por máxima entropia
+#include "lote.h"       // Avaliação do resolvedor em lote (várias threads)
+#include "servidor.h"   // Servidor de partidas (epoll)
+#include "carga.h"      // Gerador de carga para o servidor
+#include "dicionario.h" // Dicionário compilado (codlec.dic)
+#include "relogio.h"    // Relógio monotônico para medições
+#include "tela.h"       // Renderizador diferencial do terminal
+#include "resultados.h" // Gravador do histórico de partidas
+#include "salvamento.h" // Partidas em andamento salvas em arquivo
+#include "gravacao.h"   // Gravação e repetição de partidas
+#include "bench.h"      // Micro-benchmarks (--bench)
+#include "metricas.h"   // Instrumentação dos caminhos quentes (--stats)
 
 // Inclusões específicas para diferentes sistemas operacionais
 #ifdef _WIN32
@@ -11,7 +29,7 @@
 #else
     #include <termios.h>    // Para controle de terminal no Unix/Linux
     #include <unistd.h>     // Para funções POSIX
-    #include <sys/select.h> // Para função select() no Unix/Linux
+    #include <poll.h>       // Para esperar por teclas com prazo (poll) no Unix/Linux
 #endif
 
 // Códigos de Cores ANSI para colorir o terminal
@@ -24,110 +42,102 @@
 #define CLEAR_SCREEN "\033[2J\033[H"    // Limpa a tela e move cursor para início
 #define BLUE "\033[46m\033[30m"         // Para dicas (fundo azul)
 
-// Constantes do sistema de dicas
-#define MAX_HINTS 4         // Máximo de dicas permitidas por jogo
-#define HINT_DELAY 30       // Tempo em segundos entre dicas
-
-// Constantes do jogo
-#define MAX_WORD_LENGTH 6   // Comprimento máximo permitido para palavras
-#define MAX_ATTEMPTS 7      // Número máximo de tentativas por jogo
-#define WORD_LENGTH 5       // Comprimento padrão das palavras (Wordle clássico)
-#define MAX_WORDS 30000     // Capacidade máxima para lista de palavras normais
-#define HARD_MAX_WORDS 1000 // Capacidade máxima para lista de palavras difíceis
-
-// Enumeração dos níveis de dificuldade
-typedef enum {
-    EASY = 1,    // Fácil - palavras mais comuns
-    MEDIUM = 2,  // Médio - palavras de dificuldade média
-    HARD = 3,    // Difícil - palavras menos comuns
-    DEMO = 4     // Demonstração - para testes
-} Difficulty;
-
-// Estrutura principal que armazena todo o estado do jogo
+// Dicionário do jogo (listas + índice), carregado uma vez em main()
+static Motor motor;
+
+// Quadro da tela de jogo (tabuleiro, teclado e entrada), redesenhado por diferença
+static Tela tela;
+
+// Semente das partidas: --semente N torna as partidas repetíveis (N, N+1, ...);
+// sem ela, cada partida é semeada com entropia do sistema
+static int semente_fixa = 0;
+static uint64_t semente_base = 0;
+static uint64_t partidas_semeadas = 0;
+
+// Histórico de partidas (aberto no primeiro salvamento); --fsync sincroniza cada gravação
+static GravadorResultados resultados = { .fd = -1 };
+static int resultados_sincronizar = 0;
+
+// Log de eventos das partidas (--gravar); desligado enquanto gravacao.f == NULL
+static Gravacao gravacao;
+static const char* arquivo_gravacao = NULL;
+
+// Tentativa em andamento no terminal: do Enter até o quadro com a resposta (0 = nenhuma ou métricas desligadas)
+static uint64_t inicio_tentativa = 0;
+
+// Arquivos das listas padrão (podem ser trocados com --lista normal=... / dificil=...)
+static const char* arquivo_normal = "palavras.txt";
+static const char* arquivo_dificil = "palavras_dificeis.txt";
+
+// Listas extras pedidas com --lista nome=arquivo
 typedef struct {
-    char target_word[WORD_LENGTH + 1];              // Palavra secreta a ser adivinhada
-    char guesses[MAX_ATTEMPTS][WORD_LENGTH + 1];    // Array com todas as tentativas do jogador
-    int feedback[MAX_ATTEMPTS][WORD_LENGTH];        // Feedback para cada letra (0=incorreta, 1=posição errada, 2=correta)
-    int current_attempt;                            // Tentativa atual (0 a MAX_ATTEMPTS-1)
-    int max_attempts;                               // Número máximo de tentativas para este jogo
-    int game_over;                                  // Flag indicando se o jogo terminou (0=não, 1=sim)
-    int won;                                        // Flag indicando se o jogador venceu (0=não, 1=sim)
-    Difficulty difficulty;                          // Nível de dificuldade atual
-    int current_difficulty;                         // Dificuldade atual como inteiro
-    int hints_used;                                 // Número de dicas já utilizadas
-    time_t last_hint_time;                          // Timestamp da última dica solicitada
-    char revealed_letters[WORD_LENGTH + 1];         // Letras reveladas pelas dicas
-} GameState;
-
-// Arrays globais para armazenar as listas de palavras
-char word_list[MAX_WORDS][WORD_LENGTH + 1];           // Lista principal de palavras
-char hard_word_list[HARD_MAX_WORDS][WORD_LENGTH + 1]; // Lista de palavras difíceis
-int WORD_COUNT = 0;                                   // Contador de palavras carregadas na lista principal
-int HARD_WORD_COUNT = 0;                             // Contador de palavras carregadas na lista difícil
+    const char* nome;
+    const char* arquivo;
+} ListaExtra;
+static ListaExtra listas_extras[MOTOR_MAX_LISTAS];
+static int n_listas_extras = 0;
 
 // Protótipos das funções do sistema de dicas
-int can_use_hint(GameState* game);      // Verifica se o jogador pode usar uma dica
-void use_hint(GameState* game);         // Aplica uma dica ao jogo atual
 void display_hints_info(GameState* game); // Mostra informações sobre dicas disponíveis
 
 /**
- * Função multiplataforma para detectar se uma tecla foi pressionada
- * Retorna: 1 se há uma tecla disponível, 0 caso contrário
+ * Função multiplataforma que bloqueia até uma tecla ser pressionada ou o
+ * prazo acabar, sem consumir CPU enquanto espera
+ * @param timeout_ms: Prazo em milissegundos (-1 = esperar indefinidamente)
+ * Retorna: 1 se há uma tecla disponível, 0 se o prazo acabou
  */
-int kbhit(void) {
+int esperar_tecla(int timeout_ms) {
     #ifdef _WIN32
-        return _kbhit(); // Função nativa do Windows
+        HANDLE entrada = GetStdHandle(STD_INPUT_HANDLE);
+        ULONGLONG limite = GetTickCount64() + (ULONGLONG)(timeout_ms < 0 ? 0 : timeout_ms);
+        while (!_kbhit()) {
+            DWORD espera = INFINITE;
+            if (timeout_ms >= 0) {
+                ULONGLONG agora = GetTickCount64();
+                if (agora >= limite) return 0;
+                espera = (DWORD)(limite - agora);
+            }
+            if (WaitForSingleObject(entrada, espera) != WAIT_OBJECT_0) return 0;
+            // O console também sinaliza mouse, foco e teclas soltas: descarta o que não é tecla
+            INPUT_RECORD evento;
+            DWORD lidos;
+            if (!_kbhit() && PeekConsoleInput(entrada, &evento, 1, &lidos) && lidos == 1 &&
+                !(evento.EventType == KEY_EVENT && evento.Event.KeyEvent.bKeyDown)) {
+                ReadConsoleInput(entrada, &evento, 1, &lidos);
+            }
+        }
+        return 1;
     #else
-        // Implementação para sistemas Unix/Linux usando select()
-        struct timeval tv = { 0L, 0L }; // Timeout zero para não bloquear
-        fd_set fds;
-        FD_ZERO(&fds);                  // Limpa o conjunto de file descriptors
-        FD_SET(0, &fds);               // Adiciona stdin (0) ao conjunto
-        return select(1, &fds, NULL, NULL, &tv) > 0; // Verifica se stdin tem dados
+        // Implementação para sistemas Unix/Linux usando poll() bloqueante
+        struct pollfd pfd = { STDIN_FILENO, POLLIN, 0 };
+        int r = poll(&pfd, 1, timeout_ms);
+        return r > 0;  // Sinal (EINTR) conta como prazo: quem chama recalcula e espera de novo
     #endif
 }
 
-/**
- * Função para carregar palavras de um arquivo texto
- * @param destino: Array bidimensional onde as palavras serão armazenadas
- * @param nome_arquivo: Nome do arquivo a ser lido
- * @param is_hard_list: Flag indicando se é a lista de palavras difíceis (1) ou normal (0)
- * @return: Número de palavras carregadas com sucesso
- */
-int carregar_palavras(char destino[][WORD_LENGTH + 1], const char* nome_arquivo, int is_hard_list) {
-    FILE* file = fopen(nome_arquivo, "r");
-    if (!file) {
-        printf("Erro ao abrir arquivo: %s\n", nome_arquivo);
-        return 0;
-    }
-
-    char buffer[100];                                           // Buffer para leitura de linha
-    int count = 0;                                             // Contador de palavras válidas
-    int max_words = is_hard_list ? HARD_MAX_WORDS : MAX_WORDS; // Define limite baseado no tipo de lista
-    
-    // Lê o arquivo linha por linha até o final ou até atingir o limite
-    while (fgets(buffer, sizeof(buffer), file) && count < max_words) {
-        // Processa e limpa cada palavra lida
-        int valid = 1;                          // Flag para indicar se a palavra é válida
-        char cleaned[WORD_LENGTH + 1] = {0};    // Array para palavra limpa (inicializado com zeros)
-        
-        // Remove caracteres não alfabéticos e converte para maiúscula
-        for (int i = 0, j = 0; buffer[i] && j < WORD_LENGTH; i++) {
-            if (isalpha(buffer[i])) {              // Verifica se é letra
-                cleaned[j++] = toupper(buffer[i]); // Converte para maiúscula e adiciona
-            }
-        }
+/*
+    Semente da próxima partida
+    Com --semente N: N, N+1, N+2... (a mesma sequência de partidas a cada
+    execução, para reproduzir um jogo); sem ela, entropia do sistema
+*/
+uint64_t proxima_semente(void) {
+    if (semente_fixa) return semente_base + partidas_semeadas++;
+    return aleatorio_semente_sistema();
+}
 
-        // Só adiciona palavras que tenham exatamente o comprimento correto
-        if (strlen(cleaned) == WORD_LENGTH) {
-            strcpy(destino[count], cleaned);    // Copia palavra limpa para destino
-            count++;                           // Incrementa contador
-        }
-    }
+/*
+    Prazo até a próxima mudança do timer de dicas na tela
+    O timer mostra segundos inteiros até last_hint_time + HINT_DELAY: a tela
+    só precisa ser redesenhada na virada de cada segundo até lá
+    Retorna milissegundos até a próxima virada, ou -1 se não há timer ativo
+*/
+int prazo_timer_dica(const GameState* game) {
+    if (game->hints_used == 0 || game->hints_used >= MAX_HINTS) return -1;  // Sem espera de dica
+    if (time(NULL) >= game->last_hint_time + HINT_DELAY) return -1;         // Dica já liberada
 
-    fclose(file);
-    printf("Carregadas %d palavras do arquivo: %s\n", count, nome_arquivo);
-    return count;
+    struct timespec agora;
+    timespec_get(&agora, TIME_UTC);  // Mesmo relógio de time(), com frações de segundo
+    return 1000 - (int)(agora.tv_nsec / 1000000) + 1;  // +1 ms: acorda já no segundo seguinte
 }
 
 // Variável global para armazenar configurações originais do terminal (apenas Unix/Linux)
@@ -137,14 +147,11 @@ struct termios orig_termios;
 
 // Protótipos de funções - Interface e controle do jogo
 void clear_screen(void);                                    // Limpa a tela do terminal
-void init_game(GameState* game, Difficulty difficulty);     // Inicializa um novo jogo
 void display_menu(void);                                    // Exibe o menu principal
 void display_how_to_play(void);                            // Exibe as instruções do jogo
 void display_results(void);                                 // Exibe resultados/estatísticas
 void display_game_board(GameState* game);                  // Exibe o tabuleiro do jogo
 void display_keyboard(GameState* game);                     // Exibe o teclado virtual com feedback
-void process_guess(GameState* game, const char* guess);     // Processa uma tentativa do jogador
-void calculate_feedback(GameState* game, const char* guess); // Calcula feedback para uma tentativa
 void display_game_over(GameState* game, Difficulty dificuldade);// Exibe tela de fim de jogo
 
 // Protótipos de funções - Controle de console e entrada
@@ -155,25 +162,11 @@ char* get_guess_with_pause(GameState* game);               // Captura tentativa
 char get_char(void);                                       // Captura um caractere do teclado
 int get_menu_choice(void);                                 // Captura escolha do menu principal
 int get_difficulty_choice(void);                          // Captura escolha de dificuldade
-int check_word_exists(GameState* game, const char* word);  // Verifica se palavra existe no dicionário
 int get_pause_choice_robust(void);                        // Captura escolha do menu de pausa (robusto)
 int handle_pause_menu(GameState* game);                   // Gerencia o menu de pausa
-int is_position_solved(GameState* game, int position); // Adicionar com os outros protótipos
 
 // Variáveis globais para manipulação do console
 
-/*
-    Função multiplataforma para pausar a execução por um tempo específico
-    @param milliseconds: Tempo em milissegundos para pausar
-*/
-void sleep_ms(int milliseconds) {
-    #ifdef _WIN32
-        Sleep(milliseconds);                    // Função nativa do Windows (aceita milissegundos)
-    #else
-        usleep(milliseconds * 1000);          // Função Unix/Linux (aceita microssegundos, por isso *1000)
-    #endif
-}
-
 // Configuração multiplataforma do console
 
 /*
@@ -213,63 +206,7 @@ void clear_screen(void) {
         printf(CLEAR_SCREEN);  // Código ANSI para Unix/Linux
     #endif
     fflush(stdout);
-}
-
-/*
-    Inicializa um novo jogo com a dificuldade especificada
-    @param game: Ponteiro para a estrutura do estado do jogo
-    @param difficulty: Nível de dificuldade escolhido pelo jogador
-*/
-void init_game(GameState* game, Difficulty difficulty) {
-    game->difficulty = difficulty;
-    game->current_difficulty = difficulty; 
-    game->current_attempt = 0;
-    game->game_over = 0;
-    game->won = 0;
-   
-   // Define número máximo de tentativas baseado na dificuldade
-   switch (difficulty) {
-       case EASY:
-           game->max_attempts = 7;     // Fácil: 7 tentativas
-           break;
-       case MEDIUM:
-           game->max_attempts = 6;     // Médio: 6 tentativas
-           break;
-       case HARD:
-       case DEMO:
-           game->max_attempts = 5;     // Difícil/Demo: 5 tentativas
-           break;
-   }
-   
-   // Inicializa arrays de tentativas e feedback
-   for (int i = 0; i < MAX_ATTEMPTS; i++) {
-       strcpy(game->guesses[i], "");           // Limpa tentativas anteriores
-       for (int j = 0; j < WORD_LENGTH; j++) {
-           game->feedback[i][j] = -1;          // -1 = não definido/não usado
-       }
-   }
-   
-   // Seleciona palavra aleatória baseada na dificuldade
-   srand((unsigned int)time(NULL));            // Inicializa gerador de números aleatórios
-   if (difficulty == HARD) {
-       // Modo difícil: usa lista de palavras mais complexas
-       int idx = rand() % HARD_WORD_COUNT;
-       strcpy(game->target_word, hard_word_list[idx]);
-   } else {
-       // Modos fácil/médio: usa lista principal de palavras
-       int idx = rand() % WORD_COUNT;
-       strcpy(game->target_word, word_list[idx]);
-   }
-   
-   // Modo demonstração: usa palavra fixa para testes
-   if (difficulty == DEMO) {
-       strcpy(game->target_word, "TESTE");     // Palavra conhecida para debugging/demonstração
-   }
-   
-   // Inicializa sistema de dicas
-   game->hints_used = 0;                       // Nenhuma dica usada ainda
-   game->last_hint_time = 0;                   // Timestamp da última dica (0 = nunca)
-   strcpy(game->revealed_letters, "     ");    // Nenhuma letra revelada ainda (5 espaços)
+    tela_invalidar(&tela);  // O último quadro do renderizador não está mais na tela
 }
 
 /*
@@ -312,8 +249,9 @@ void display_pause_menu(void) {
    printf("  %s=== JOGO PAUSADO ===%s\n\n", BOLD, RESET);
    printf("  1. %sContinuar Jogando%s\n", GREEN, RESET);    // Verde: ação positiva
    printf("  2. %sReiniciar Jogo%s\n", YELLOW, RESET);      // Amarelo: ação de mudança
-   printf("  3. %sDesistir%s\n\n", GRAY, RESET);            // Cinza: ação de saída
-   printf("  Selecione uma opção (1-3): ");
+   printf("  3. %sDesistir%s\n", GRAY, RESET);              // Cinza: ação de saída
+   printf("  4. %sSalvar e Voltar ao Menu%s\n\n", BLUE, RESET); // Azul: a partida continua depois
+   printf("  Selecione uma opção (1-4): ");
 }
 
 /*
@@ -323,7 +261,7 @@ void display_pause_menu(void) {
 void display_how_to_play(void) {
    clear_screen();
    printf("\n%s=== COMO JOGAR ===%s\n\n", BOLD, RESET);
-   printf("🎯 %sObjetivo:%s Adivinhe a palavra secreta de 5 letras!\n\n", BOLD, RESET);
+   printf("🎯 %sObjetivo:%s Adivinhe a palavra secreta (5 letras no modo clássico)!\n\n", BOLD, RESET);
    
    printf("📏 %sNíveis de Dificuldade:%s\n", BOLD, RESET);
    printf("   • %sFácil:%s   7 tentativas para adivinhar\n", GREEN, RESET);
@@ -337,7 +275,7 @@ void display_how_to_play(void) {
    printf("   %s X %s Letra não está na palavra\n\n", GRAY, RESET);
    
    printf("💡 %sDicas:%s\n", BOLD, RESET);
-   printf("   • Todas as palavras têm 5 letras\n");
+   printf("   • Clássico: 5 letras; com palavras_4.txt, palavras_6.txt... também 4, 6, 7 ou 8\n");
    printf("   • Apenas palavras válidas em português são aceitas\n");
    printf("   • Letras podem aparecer múltiplas vezes\n");
    printf("   • Use o feedback para guiar sua próxima tentativa\n\n");
@@ -346,84 +284,218 @@ void display_how_to_play(void) {
    get_char();
 }
 
+#define ULTIMAS_PARTIDAS 8  // Partidas recentes listadas na tela de resultados
+#define HISTORICO_POR_PAGINA 15  // Partidas por página no histórico completo
+
 /*
-    Exibe os resultados salvos dos jogos anteriores
-    Lê o arquivo JSON com histórico, calcula estatísticas e mostra resumo
-    Inclui: lista de jogos, total de vitórias e média de tentativas
+    Converte "AAAA-MM-DD" (hora local) em segundos desde 1970
+    @param fim_do_dia: 1 = 23:59:59 do dia (limite final de um intervalo)
+    Retorna 1 se a data é válida
 */
-void display_results(void) {
-    // Limpa a tela para exibir os resultados
-    clear_screen();
-    
+int ler_data(const char* texto, int fim_do_dia, int64_t* destino) {
+    int ano, mes, dia;
+    if (sscanf(texto, "%d-%d-%d", &ano, &mes, &dia) != 3 || mes < 1 || mes > 12 || dia < 1 || dia > 31) return 0;
+    struct tm data;
+    memset(&data, 0, sizeof(data));
+    data.tm_year = ano - 1900;
+    data.tm_mon = mes - 1;
+    data.tm_mday = dia;
+    data.tm_hour = fim_do_dia ? 23 : 0;
+    data.tm_min = fim_do_dia ? 59 : 0;
+    data.tm_sec = fim_do_dia ? 59 : 0;
+    data.tm_isdst = -1;                 // Horário de verão decidido pelo sistema
+    time_t t = mktime(&data);
+    if (t == (time_t)-1) return 0;
+    *destino = (int64_t)t;
+    return 1;
+}
+
+// "AAAA-MM-DD HH:MM" de um registro ("-" para linhas antigas, sem data)
+void formatar_data(int64_t quando, char* destino, size_t tamanho) {
+    time_t t = (time_t)quando;
+    struct tm* local = quando > 0 ? localtime(&t) : NULL;
+    if (!local || strftime(destino, tamanho, "%Y-%m-%d %H:%M", local) == 0) snprintf(destino, tamanho, "%-16s", "-");
+}
+
+// Uma partida do histórico em uma linha
+void print_registro(const RegistroResultado* r) {
+    char data[32];
+    formatar_data(r->quando, data, sizeof(data));
+    printf("  %s | %-8.*s | %d/%d tentativa(s) | %d dica(s) | %s | %s\n", data, r->letras, r->palavra,
+           r->tentativas, r->max_tentativas ? r->max_tentativas : r->tentativas, r->dicas,
+           r->venceu ? "Vitória" : "Derrota", resultados_nome_dificuldade(r->dificuldade));
+}
+
+/*
+    Histórico completo, página a página, sem carregar o arquivo na memória
+    Cada página guarda só o byte onde começa; voltar usa as posições já vistas
+    Teclas: N/P (próxima/anterior), 0-4 (dificuldade), V/D/T (vitórias/derrotas/todas), Q (voltar)
+*/
+void display_historico(void) {
+    FiltroResultados filtro;
+    memset(&filtro, 0, sizeof(filtro));
+    filtro.resultado = -1;
+
+    uint64_t* paginas = NULL;       // Byte inicial de cada página já visitada
+    size_t n_paginas = 0, cap_paginas = 0, pagina = 0;
+    uint64_t inicio = 0;
+
+    while (1) {
+        RegistroResultado registros[HISTORICO_POR_PAGINA];
+        uint64_t proximo;
+        int n = resultados_consultar(RESULTADOS_ARQUIVO, &filtro, inicio, 0, registros, HISTORICO_POR_PAGINA, &proximo);
+        int ultima = n < HISTORICO_POR_PAGINA ||
+                     resultados_consultar(RESULTADOS_ARQUIVO, &filtro, proximo, 0, NULL, 1, NULL) == 0;
+
+        clear_screen();
+        printf("\n%s=== HISTÓRICO (página %zu) ===%s  Filtro: %s, %s\n\n", BOLD, pagina + 1, RESET,
+               filtro.dificuldade ? resultados_nome_dificuldade(filtro.dificuldade) : "todas as dificuldades",
+               filtro.resultado < 0 ? "vitórias e derrotas" : filtro.resultado ? "só vitórias" : "só derrotas");
+        for (int i = 0; i < n; i++) print_registro(&registros[i]);
+        if (n == 0) printf("  Nenhuma partida encontrada.\n");
+        printf("\n  %sN%s próxima | %sP%s anterior | %s0-4%s dificuldade | %sV/D/T%s vitórias/derrotas/todas | %sQ%s voltar\n",
+               BOLD, RESET, BOLD, RESET, BOLD, RESET, BOLD, RESET, BOLD, RESET);
+
+        char c = (char)toupper((unsigned char)get_char());
+        if (c == 'N' && !ultima) {
+            if (n_paginas == cap_paginas) {
+                size_t cap = cap_paginas ? cap_paginas * 2 : 64;
+                uint64_t* novo = realloc(paginas, cap * sizeof(*novo));
+                if (!novo) continue;
+                paginas = novo;
+                cap_paginas = cap;
+            }
+            paginas[n_paginas++] = inicio;
+            inicio = proximo;
+            pagina++;
+        } else if (c == 'P' && n_paginas > 0) {
+            inicio = paginas[--n_paginas];
+            pagina--;
+        } else if ((c >= '0' && c <= '4') || c == 'V' || c == 'D' || c == 'T') {
+            if (c >= '0' && c <= '4') filtro.dificuldade = c - '0';
+            else filtro.resultado = c == 'V' ? 1 : c == 'D' ? 0 : -1;
+            inicio = 0;                 // Filtro novo: volta à primeira página
+            n_paginas = 0;
+            pagina = 0;
+        } else if (c == 'Q' || c == 27) {
+            break;
+        }
+    }
+    free(paginas);
+}
+
+// Emoji de cada dificuldade na tela de resultados
+void print_emoji_dificuldade(FILE* saida, int dificuldade) {
+    switch (dificuldade) {
+        case EASY:   fprintf(saida, "%s😊%s", GREEN, RESET); break;
+        case MEDIUM: fprintf(saida, "%s😎%s", YELLOW, RESET); break;
+        case HARD:   fprintf(saida, "%s🤯%s", GRAY, RESET); break;
+        default:     fprintf(saida, "%s🤖%s", WHITE, RESET); break;
+    }
+}
+
+/*
+    Escreve a tela de resultados do histórico `arquivo` em `saida`
+    Os totais vêm do resumo mantido junto ao histórico (resultados.json.resumo):
+    abrir a tela não relê o histórico inteiro, por maior que ele seja
+    Inclui: totais por dificuldade, distribuição de tentativas, sequências
+    de vitórias e as últimas partidas (lidas só do final do arquivo)
+    Retorna 0 se ainda não há resultados
+*/
+int imprimir_resultados(FILE* saida, const char* arquivo) {
     // Exibe o cabeçalho dos resultados do jogo
-    printf("\n%s=== RESULTADOS DO JOGO ===%s\n\n", BOLD, RESET);
-    // Tenta abrir o arquivo de resultados para leitura
-    FILE* file = fopen("resultados.json", "r");
-    if (!file) {
+    fprintf(saida, "\n%s=== RESULTADOS DO JOGO ===%s\n\n", BOLD, RESET);
+
+    ResumoResultados resumo;
+    if (!resultados_carregar_resumo(arquivo, &resumo)) {
         // Se o arquivo não existe, informa que não há resultados salvos
-        printf("Nenhum resultado salvo ainda.\n");
-        printf("Pressione qualquer tecla para retornar ao menu...");
-        get_char();
-        return;
+        fprintf(saida, "Nenhum resultado salvo ainda.\n");
+        return 0;
     }
-    // Variáveis para armazenar dados temporários e estatísticas
-    char linha[256];           // Buffer para ler cada linha do arquivo
-    int total_games = 0;       // Contador do total de jogos
-    int total_tentativas = 0;  // Soma total de tentativas
-    int wins = 0;              // Contador de vitórias
-    char dificuldade[20];      // Armazena a dificuldade do jogo
-    
-    printf("Resultados salvos:\n\n");
-    // Lê o arquivo linha por linha
-    while (fgets(linha, sizeof(linha), file)) {
-        char palavra[WORD_LENGTH + 1];  // Armazena a palavra do jogo
-        int tentativas;                 // Armazena o número de tentativas
-        // Extrai a palavra e tentativas do formato JSON
-        // Formato esperado: {"palavra": "XXXXX", "tentativas": N, "dificuldade": "XXXXX"}
-        if (sscanf(linha, "{\"palavra\": \"%5[^\"]\", \"tentativas\": %d, \"dificuldade\": \"%19[^\"]\"}", palavra, &tentativas, dificuldade) == 3) {
-            // Exibe os dados do jogo individual
-            printf("  Palavra: %-5s | Tentativas: %d | Dificuldade: %-12s ", palavra, tentativas, dificuldade);
-            
-            if (strcmp(dificuldade, "FÁCIL") == 0) {
-                printf("%s😊%s", GREEN, RESET);
-            } else if (strcmp(dificuldade, "MÉDIO") == 0) {
-                printf("%s😎%s", YELLOW, RESET);
-            } else if (strcmp(dificuldade, "DIFÍCIL") == 0) {
-                printf("%s🤯%s", GRAY, RESET);
-            } else {
-                printf("%s🤖%s", WHITE, RESET);
+
+    // Últimas partidas, da mais antiga para a mais recente
+    RegistroResultado ultimas[ULTIMAS_PARTIDAS];
+    int n_ultimas = resultados_ultimas(arquivo, ultimas, ULTIMAS_PARTIDAS);
+    fprintf(saida, "Últimas partidas:\n\n");
+    for (int i = 0; i < n_ultimas; i++) {
+        fprintf(saida, "  Palavra: %-8.*s | Tentativas: %d | %s | Dificuldade: %-12s ",
+                       ultimas[i].letras, ultimas[i].palavra, ultimas[i].tentativas,
+                       ultimas[i].venceu ? "Vitória" : "Derrota", resultados_nome_dificuldade(ultimas[i].dificuldade));
+        print_emoji_dificuldade(saida, ultimas[i].dificuldade);
+        fprintf(saida, "\n");
+    }
+
+    // Totais por dificuldade (só as que já foram jogadas)
+    uint64_t total_games = 0, wins = 0, total_tentativas = 0;
+    for (int d = EASY; d <= DEMO; d++) {
+        const ResumoDificuldade* r = &resumo.dificuldades[d];
+        if (r->jogos == 0) continue;
+        total_games += r->jogos;
+        wins += r->vitorias;
+        total_tentativas += r->tentativas_vitorias;
+
+        fprintf(saida, "\n");
+        print_emoji_dificuldade(saida, d);
+        fprintf(saida, " %s%s%s: %llu jogo(s), %llu vitória(s) (%.0f%%)", BOLD, resultados_nome_dificuldade(d), RESET,
+                       (unsigned long long)r->jogos, (unsigned long long)r->vitorias, 100.0 * r->vitorias / r->jogos);
+        if (r->vitorias > 0) fprintf(saida, ", média %.2f", (double)r->tentativas_vitorias / r->vitorias);
+        fprintf(saida, "\n   Sequência atual: %u | Melhor sequência: %u | Dicas usadas: %llu\n",
+                       r->sequencia, r->melhor_sequencia, (unsigned long long)r->dicas);
+
+        // Distribuição das vitórias por número de tentativas
+        fprintf(saida, "   Vitórias por tentativa:");
+        for (int t = 1; t <= RESULTADOS_MAX_TENTATIVAS; t++) {
+            if (r->vitorias_em[t] > 0 || t <= MAX_ATTEMPTS) {
+                fprintf(saida, " %d:%llu", t, (unsigned long long)r->vitorias_em[t]);
             }
-            printf("\n");
-            
-            // Atualiza as estatísticas
-            total_games++;
-            total_tentativas += tentativas;
-            wins++; // Considera que só salva se ganhou
         }
+        fprintf(saida, "\n");
     }
-    // Fecha o arquivo
-    fclose(file);
+
     // Exibe o resumo das estatísticas
-    printf("\nResumo:\n");
-    printf("  • Jogos vencidos: %d\n", wins);
-    printf("  • Total de jogos: %d\n", total_games);
+    fprintf(saida, "\nResumo:\n");
+    fprintf(saida, "  • Jogos vencidos: %llu\n", (unsigned long long)wins);
+    fprintf(saida, "  • Total de jogos: %llu\n", (unsigned long long)total_games);
     
-    // Calcula e exibe a média de tentativas apenas se houver jogos
-    if (total_games > 0)
-        printf("  • Média de tentativas por vitória: %.2f\n", (float)total_tentativas / total_games);
-    // Aguarda input do usuário para retornar ao menu
-    printf("\nPressione qualquer tecla para retornar ao menu...");
-    get_char();
+    // Calcula e exibe a média de tentativas apenas se houver vitórias
+    if (wins > 0)
+        fprintf(saida, "  • Média de tentativas por vitória: %.2f\n", (double)total_tentativas / (double)wins);
+    if (resumo.ignoradas > 0)
+        fprintf(saida, "  • Linhas inválidas ignoradas: %llu (use --compactar-resultados)\n",
+                       (unsigned long long)resumo.ignoradas);
+    return 1;
 }
 
 /*
-    Exibe o tabuleiro principal do jogo em tempo real
+    Exibe os resultados salvos dos jogos anteriores (imprimir_resultados)
+    e espera uma tecla: H abre o histórico completo
+*/
+void display_results(void) {
+    // Limpa a tela para exibir os resultados
+    clear_screen();
+    if (resultados.fd >= 0) resultados_descarregar(&resultados);  // Nada pendente fica de fora
+
+    if (!imprimir_resultados(stdout, RESULTADOS_ARQUIVO)) {
+        printf("Pressione qualquer tecla para retornar ao menu...");
+        get_char();
+        return;
+    }
+
+    // Aguarda input do usuário: H abre o histórico completo, o resto volta ao menu
+    printf("\n%sH%s histórico completo | qualquer outra tecla retorna ao menu...", BOLD, RESET);
+    char c = get_char();
+    if (c == 'h' || c == 'H') display_historico();
+}
+
+/*
+    Compõe o tabuleiro principal do jogo no quadro do renderizador
     Mostra tentativas anteriores com feedback colorido, tentativa atual,
     dicas reveladas e informações de status (dificuldade, tentativas restantes)
+    Começa um quadro novo; a tela só muda em desenhar_jogo (tela_apresentar)
 */
 void display_game_board(GameState* game) {
-    clear_screen();
-    printf("\n%s=== CodleC ===%s", BOLD, RESET);
+    tela_limpar(&tela);
+    tela_printf(&tela, "\n%s=== CodleC ===%s", BOLD, RESET);
     
     const char* diff_names[] = {
         "",      // Índice 0 não usado
@@ -432,51 +504,48 @@ void display_game_board(GameState* game) {
         "DIFÍCIL", // Índice 3 (HARD)
         "DEMO"   // Índice 4 (DEMO)
     };
-    printf(" [%s%s%s] Tentativas: %d/%d\n", 
+    tela_printf(&tela, " [%s%s%s] Tentativas: %d/%d\n", 
            BOLD, diff_names[game->difficulty], RESET,
            game->current_attempt, game->max_attempts);
     
     // Instruções fixas
-    printf("%sDigite 'P' para pausar | Digite 'H' para dica%s\n", WHITE, RESET);
+    tela_printf(&tela, "%sDigite 'P' para pausar | Digite 'H' para dica%s\n", WHITE, RESET);
     
     // Mostrar informações das dicas
     display_hints_info(game);
-    printf("\n");
+    tela_printf(&tela, "\n");
     
     // Display the grid
     for (int i = 0; i < game->max_attempts; i++) {
-        printf("  ");
-        for (int j = 0; j < WORD_LENGTH; j++) {
+        tela_printf(&tela, "  ");
+        for (int j = 0; j < game->letras; j++) {
             char letter = ' ';
             const char* color = WHITE;
             
-            if (i < game->current_attempt && strlen(game->guesses[i]) == WORD_LENGTH) {
-                letter = game->guesses[i][j];
-                switch (game->feedback[i][j]) {
+            if (i < game->current_attempt) {
+                letter = KEY_CHAR(game->guesses[i], j);
+                switch (feedback_letra(game, i, j)) {
                     case 2: color = GREEN; break;   // Correct position
                     case 1: color = YELLOW; break;  // Wrong position
                     case 0: color = GRAY; break;    // Not in word
                     default: color = WHITE; break;
                 }
-            } else if (i == game->current_attempt && strlen(game->guesses[i]) > j) {
-                letter = game->guesses[i][j];
-                color = WHITE;
             }
             // NOVO: Mostrar dicas reveladas diretamente no grid
-            else if (game->revealed_letters[j] != ' ') {
-                letter = game->revealed_letters[j];
+            else if (game->reveladas & (1u << j)) {
+                letter = letra_secreta(game, j);
                 color = BLUE;
             }
             
-            printf("%s %c %s ", color, letter, RESET);
+            tela_printf(&tela, "%s %c %s ", color, letter, RESET);
         }
-        printf("\n");
+        tela_printf(&tela, "\n");
     }
-    printf("\n");
+    tela_printf(&tela, "\n");
 }
 
 /*
-    Exibe o teclado virtual com status das letras já utilizadas
+    Compõe o teclado virtual com status das letras já utilizadas
     Mostra feedback colorido: verde (posição correta), amarelo (letra existe),
     cinza (não existe na palavra), branco (ainda não testada)
 */
@@ -491,55 +560,58 @@ void display_keyboard(GameState* game) {
     // Número de letras em cada fileira do teclado
     int lengths[3] = {10, 9, 7};
     
-    printf("Status do Teclado:\n");
+    tela_printf(&tela, "Status do Teclado:\n");
     
     // Percorre cada fileira do teclado
     for (int row = 0; row < 3; row++) {
-        printf("  "); // Indentação base
+        tela_printf(&tela, "  "); // Indentação base
         
         // Indentação adicional para simular layout de teclado real
-        if (row == 1) printf(" ");    // Fileira do meio: 1 espaço extra
-        if (row == 2) printf("  ");   // Fileira inferior: 2 espaços extras
+        if (row == 1) tela_printf(&tela, " ");    // Fileira do meio: 1 espaço extra
+        if (row == 2) tela_printf(&tela, "  ");   // Fileira inferior: 2 espaços extras
         
         // Percorre cada letra da fileira atual
         for (int col = 0; col < lengths[row]; col++) {
             char letter = keyboard[row][col];
             const char* color = WHITE; // Cor padrão: branco (não testada)
             
-            // Verifica o status da letra em todas as tentativas anteriores
-            for (int i = 0; i < game->current_attempt; i++) {
-                for (int j = 0; j < WORD_LENGTH; j++) {
-                    // Se a letra foi usada em alguma tentativa
-                    if (game->guesses[i][j] == letter) {
-                        switch (game->feedback[i][j]) {
-                            case 2: // Posição correta (sempre prevalece)
-                                color = GREEN;
-                                break;
-                            case 1: // Letra existe mas posição errada
-                                if (color != GREEN) color = YELLOW;
-                                break;
-                            case 0: // Letra não existe na palavra
-                                if (color != GREEN && color != YELLOW) color = GRAY;
-                                break;
-                        }
-                    }
-                }
+            // Status mantido pelo motor a cada tentativa: só uma consulta
+            switch (status_letra(game, letter)) {
+                case TECLA_VERDE: color = GREEN; break;     // Posição correta (sempre prevalece)
+                case TECLA_AMARELA: color = YELLOW; break;  // Letra existe mas posição errada
+                case TECLA_CINZA: color = GRAY; break;      // Letra não existe na palavra
+                default: break;
             }
             
             // Exibe a letra com a cor correspondente ao seu status
-            printf("%s %c %s", color, letter, RESET);
+            tela_printf(&tela, "%s %c %s", color, letter, RESET);
         }
-        printf("\n"); // Nova linha após cada fileira
+        tela_printf(&tela, "\n"); // Nova linha após cada fileira
     }
-    printf("\n"); // Espaço após o teclado
+    tela_printf(&tela, "\n"); // Espaço após o teclado
 }
 
 /*
-    Salva o resultado de uma partida vencedora no arquivo JSON
-    Registra a palavra descoberta e o número de tentativas utilizadas
-    Formato: uma linha JSON por vitória para fácil leitura posterior
+    Desenha a tela de jogo completa em um quadro: tabuleiro, teclado, uma
+    mensagem opcional e o prompt com o que já foi digitado
+    Só as células que mudaram desde o quadro anterior são enviadas ao terminal
+    @param digitado: Letras digitadas até agora (NULL = sem prompt, ex.: fim de jogo)
+    @param mensagem: Texto exibido acima do prompt (NULL = nenhum)
 */
-    
+void desenhar_jogo(GameState* game, const char* digitado, int n, const char* mensagem) {
+    uint64_t inicio = metricas_inicio();
+    display_game_board(game);
+    display_keyboard(game);
+    if (mensagem) tela_printf(&tela, "%s\n", mensagem);
+    if (digitado) tela_printf(&tela, "Digite seu palpite: %.*s", n, digitado);
+    size_t bytes = tela_apresentar(&tela, 1);
+    metricas_registrar_bytes(METRICA_TELA, inicio, bytes);
+
+    // O primeiro quadro depois de um palpite é a resposta que o jogador vê
+    metricas_registrar(METRICA_TENTATIVA, inicio_tentativa);
+    inicio_tentativa = 0;
+}
+
     const char* diff_names[] = {
         "",      // Índice 0 não usado
         "FÁCIL", // Índice 1 (EASY)
@@ -547,69 +619,68 @@ void display_keyboard(GameState* game) {
         "DIFÍCIL", // Índice 3 (HARD)
         "DEMO"   // Índice 4 (DEMO)
     };
-void salvar_resultado_json(const char* palavra, int tentativas, Difficulty dificuldade) {
-    // Abre o arquivo em modo append (adicionar ao final)
-    FILE* file = fopen("resultados.json", "a");
-    
-    if (file) {
-        // Escreve uma linha JSON com os dados da partida
-        // Formato: {"palavra": "XXXXX", "tentativas": N, "Dificuldade": "X"}
-        fprintf(file, "{\"palavra\": \"%s\", \"tentativas\": %d, \"dificuldade\": \"%s\"}\n", 
-               palavra, tentativas, diff_names[dificuldade]);
-        
-        // Fecha o arquivo para garantir que os dados sejam salvos
-        fclose(file);
+
+/*
+    Salva a partida em andamento em partida.sav (substituída a cada jogada
+    e a cada dica), para continuar depois de sair pelo menu de pausa ou de
+    uma queda do programa
+*/
+void salvar_partida(const GameState* game) {
+    SalvamentoEscrita e;
+    if (!salvamento_iniciar(&e, SALVAMENTO_PARTIDA)) return;
+    if (!salvamento_escrever(&e, game, 0)) {
+        salvamento_cancelar(&e);
+        return;
     }
-    // Nota: Se falhar ao abrir o arquivo, a função termina silenciosamente
-    // Em uma versão mais robusta, poderia exibir mensagem de erro
+    salvamento_concluir(&e);
+}
+
+// Apaga a partida salva (partida encerrada, abandonada ou recusada)
+void descartar_partida_salva(void) {
+    remove(SALVAMENTO_PARTIDA);
 }
 
 /*
-    Calcula o feedback colorido para uma tentativa do jogador
-    Compara a palavra tentada com a palavra-alvo usando algoritmo de duas passadas
-    Retorna: 2=posição correta, 1=letra existe mas posição errada, 0=não existe
+    Oferece continuar a partida salva, se houver uma
+    Retorna 1 se `game` foi restaurada; recusada (ou inválida), ela é descartada
 */
-void calculate_feedback(GameState* game, const char* guess) {
-    int attempt = game->current_attempt;
-    char target[WORD_LENGTH + 1];      // Cópia da palavra-alvo para manipulação
-    char guess_copy[WORD_LENGTH + 1];  // Cópia da tentativa para manipulação
-    
-    // Cria cópias das strings para não modificar as originais
-    strcpy(target, game->target_word);
-    strcpy(guess_copy, guess);
-    
-    // Inicializa todo o feedback como 0 (letra não existe na palavra)
-    for (int i = 0; i < WORD_LENGTH; i++) {
-        game->feedback[attempt][i] = 0; // Padrão: não está na palavra
-    }
-    
-    // PRIMEIRA PASSADA: marca posições corretas (prioridade máxima)
-    for (int i = 0; i < WORD_LENGTH; i++) {
-        if (guess_copy[i] == target[i]) {
-            game->feedback[attempt][i] = 2; // Posição correta (verde)
-            target[i] = '*';                // Marca como usada na palavra-alvo
-            guess_copy[i] = '*';            // Marca como processada na tentativa
-        }
+int retomar_partida_salva(GameState* game) {
+    PartidaSalva* partidas;
+    int64_t n = salvamento_carregar(SALVAMENTO_PARTIDA, &partidas);
+    if (n < 0) return 0;                            // Nenhuma partida salva
+    int ok = n == 1 && salvamento_restaurar(&partidas[0], &motor, game) && !game->game_over;
+    free(partidas);
+    if (!ok) {
+        descartar_partida_salva();
+        return 0;
     }
-    
-    // SEGUNDA PASSADA: marca posições erradas (letra existe mas local errado)
-    for (int i = 0; i < WORD_LENGTH; i++) {
-        if (guess_copy[i] != '*') { // Se ainda não foi processada
-            // Procura a letra em outras posições da palavra-alvo
-            for (int j = 0; j < WORD_LENGTH; j++) {
-                if (target[j] == guess_copy[i]) {
-                    game->feedback[attempt][i] = 1; // Posição errada (amarelo)
-                    target[j] = '*';                // Marca como usada
-                    break; // Para evitar múltiplas marcações da mesma letra
-                }
-            }
-        }
+
+    clear_screen();
+    printf("\n%sHá uma partida salva:%s %s, %d letras, tentativa %d de %d, %d dica(s) usada(s)\n\n",
+           BOLD, RESET, resultados_nome_dificuldade(game->difficulty), game->letras,
+           game->current_attempt + 1, game->max_attempts, game->hints_used);
+    printf("Continuar essa partida? (S/N): ");
+    char resposta = get_char();
+    if (resposta == 's' || resposta == 'S') return 1;
+    descartar_partida_salva();
+    return 0;
+}
+
+/*
+    Salva o resultado de uma partida (vitória ou derrota) no arquivo JSON
+    Registra palavra, tentativas, dificuldade, data, dicas usadas e desfecho
+    O arquivo fica aberto até a saída do jogo; no modo interativo não há
+    lote (cada partida é gravada na hora, com um único write)
+    Retorna 1 se o registro foi gravado
+*/
+int salvar_resultado_json(const GameState* game) {
+    if (resultados.fd < 0 &&
+        !resultados_abrir(&resultados, RESULTADOS_ARQUIVO, 0, 0.0, resultados_sincronizar)) {
+        return 0;
     }
-    
-    // Resultado final no array feedback[attempt]:
-    // 2 = Verde: letra correta na posição correta
-    // 1 = Amarelo: letra existe na palavra mas posição errada  
-    // 0 = Cinza: letra não existe na palavra-alvo
+    RegistroResultado registro;
+    resultados_de_partida(&registro, game, time(NULL));
+    return resultados_gravar(&resultados, &registro);
 }
 
 /*
@@ -638,51 +709,6 @@ void clean_word(char *word) {
     // Exemplo: "ca$a 123" → "CASA"
 }
 
-/*
-    Revela uma letra da palavra-alvo como dica para o jogador
-    Escolhe aleatoriamente uma posição ainda não revelada ou acertada
-    Atualiza estatísticas de uso de dicas e marca o tempo da última dica
-*/
-void use_hint(GameState* game) {
-    // Encontrar posições disponíveis (não reveladas E não acertadas)
-    int available_positions[WORD_LENGTH];  // Array para armazenar posições válidas
-    int count = 0;                         // Contador de posições disponíveis
-    
-    // Percorre todas as posições da palavra
-    for (int i = 0; i < WORD_LENGTH; i++) {
-        // Verifica se a posição está disponível para dica
-        if (game->revealed_letters[i] == ' ' && !is_position_solved(game, i)) {
-            available_positions[count++] = i;  // Adiciona à lista de disponíveis
-        }
-    }
-    
-    // Verifica se ainda há posições disponíveis para dicas
-    if (count == 0) {
-        printf("Todas as letras disponíveis já foram reveladas ou acertadas!\n");
-        printf("Pressione qualquer tecla para continuar...");
-        get_char();
-        return;  // Sai da função se não há dicas possíveis
-    }
-    
-    // Escolher uma posição aleatória entre as disponíveis
-    int pos = available_positions[rand() % count];
-    
-    // Revela a letra na posição escolhida
-    game->revealed_letters[pos] = game->target_word[pos];
-    
-    // Atualiza estatísticas de dicas
-    game->hints_used++;                    // Incrementa contador de dicas usadas
-    game->last_hint_time = time(NULL);     // Registra o tempo da última dica
-    
-    // Exibe mensagem de confirmação da dica revelada
-    printf("%sDica revelada!%s Letra na posição %d: %s%c%s\n", 
-           BLUE, RESET, pos + 1, BOLD, game->target_word[pos], RESET);
-    printf("Pressione qualquer tecla para continuar...");
-    get_char();
-    
-    // A letra revelada aparecerá em azul no tabuleiro na próxima atualização
-}
-
 /*
     Exibe uma barra de progresso visual para o tempo de espera das dicas
     Mostra countdown em formato gráfico com blocos preenchidos e vazios
@@ -694,19 +720,19 @@ void display_timer_bar(int remaining) {
     // Calcula quantas barras devem estar preenchidas proporcionalmente
     int filled_bars = (remaining * total_bars) / HINT_DELAY;
     
-    printf("[");  // Início da barra visual
+    tela_printf(&tela, "[");  // Início da barra visual
     
     // Desenha a barra de progresso
     for (int i = 0; i < total_bars; i++) {
         if (i < filled_bars) {
-            printf("█");  // Bloco preenchido (tempo restante)
+            tela_printf(&tela, "█");  // Bloco preenchido (tempo restante)
         } else {
-            printf("░");  // Bloco vazio (tempo decorrido)
+            tela_printf(&tela, "░");  // Bloco vazio (tempo decorrido)
         }
     }
     
     // Finaliza com o tempo numérico em segundos
-    printf("] %02ds", remaining);
+    tela_printf(&tela, "] %02ds", remaining);
     
     // Resultado visual: barra diminui conforme o tempo passa
     // Exemplo: [█████████░░░░░░] 06s → [████░░░░░░░░░░░] 03s
@@ -720,7 +746,7 @@ void display_timer_bar(int remaining) {
 void display_hints_info(GameState* game) {
 
     // Exibe contador básico de dicas utilizadas
-    printf("Dicas: %d/%d usadas", game->hints_used, MAX_HINTS);
+    tela_printf(&tela, "Dicas: %d/%d usadas", game->hints_used, MAX_HINTS);
     
     // Se ainda há dicas disponíveis para usar
     if (game->hints_used < MAX_HINTS) {
@@ -734,16 +760,16 @@ void display_hints_info(GameState* game) {
             
             if (remaining > 0) {
                 // Ainda em cooldown - mostra barra de progresso
-                printf(" - Próxima dica: ");
+                tela_printf(&tela, " - Próxima dica: ");
                 display_timer_bar(remaining);
                 
             } else {
                 // Cooldown terminado - dica disponível
-                printf(" - %s✓ DISPONÍVEL%s", GREEN, RESET);
+                tela_printf(&tela, " - %s✓ DISPONÍVEL%s", GREEN, RESET);
             }
         } else {
             // Primeira dica - sempre disponível (sem cooldown)
-            printf(" - %s✓ DISPONÍVEL%s", GREEN, RESET);
+            tela_printf(&tela, " - %s✓ DISPONÍVEL%s", GREEN, RESET);
         }
     }
     // Se atingiu o limite máximo de dicas, não exibe status adicional
@@ -755,82 +781,41 @@ void display_hints_info(GameState* game) {
     // "Dicas: 3/3 usadas" (sem status adicional)
 }
 
-/*
-    Processa uma tentativa válida do jogador no jogo
-    Registra a palavra, calcula feedback, verifica vitória e atualiza estado
-    Determina se o jogo continua, foi vencido ou perdido
-*/
-void process_guess(GameState* game, const char* guess) {
-    // Registra a tentativa atual no histórico do jogo
-    strcpy(game->guesses[game->current_attempt], guess);
-    
-    // Calcula o feedback colorido para a tentativa
-    calculate_feedback(game, guess);
-    
-    // Verifica se o jogador acertou a palavra (vitória)
-    int correct_count = 0;  // Contador de letras na posição correta
-    
-    for (int i = 0; i < WORD_LENGTH; i++) {
-        // Conta quantas letras estão na posição correta (feedback = 2)
-        if (game->feedback[game->current_attempt][i] == 2) {
-            correct_count++;
-        }
-    }
-    
-    // Se todas as letras estão corretas = vitória
-    if (correct_count == WORD_LENGTH) {
-        game->won = 1;        // Marca como vencido
-        game->game_over = 1;  // Finaliza o jogo
-    }
-    
-    // Avança para a próxima tentativa
-    game->current_attempt++;
-    
-    // Verifica se esgotou todas as tentativas (derrota)
-    if (game->current_attempt >= game->max_attempts) {
-        game->game_over = 1;  // Finaliza o jogo por falta de tentativas
-        // Nota: game->won permanece 0 (não venceu)
-    }
-    
-    // Estados possíveis após esta função:
-    // 1. Jogo continua: game_over=0, won=0
-    // 2. Vitória: game_over=1, won=1  
-    // 3. Derrota: game_over=1, won=0
-}
-
 /*
     Exibe a tela final do jogo com resultado da partida
     Mostra mensagem de vitória ou derrota, palavra-alvo e oferece salvamento
-    Permite ao jogador salvar resultado em caso de vitória
+    Permite ao jogador salvar o resultado, vencendo ou perdendo
 */
 void display_game_over(GameState* game, Difficulty dificuldade) {
     printf("\n%s=== FIM DE JOGO ===%s\n\n", BOLD, RESET);
     
+    (void)dificuldade;  // A dificuldade gravada vem da própria partida
+    char palavra[PALAVRA_MAX + 1];
+    palavra_secreta(game, palavra);
+
     // Verifica se o jogador venceu a partida
     if (game->won) {
         // Mensagem de vitória com celebração
         printf("%s🎉 Parabéns! Você venceu! 🎉%s\n", GREEN, RESET);
         printf("Você adivinhou a palavra %s%s%s em %d tentativa(s)!\n\n",
-               BOLD, game->target_word, RESET, game->current_attempt);
-
-        // Oferece opção para salvar o resultado da vitória
-        printf("Deseja salvar o resultado? (S/N): ");
-        char c = toupper(get_char());  // Converte para maiúscula
-        
-        if (c == 'S') {
-            // Salva no arquivo JSON com palavra e número de tentativas
-            salvar_resultado_json(game->target_word, game->current_attempt, dificuldade);
-            printf("\nResultado salvo com sucesso!\n");
-        }
-        // Se escolher 'N' ou qualquer outra tecla, não salva
-        
+               BOLD, palavra, RESET, game->current_attempt);
     } else {
         // Mensagem de derrota com encorajamento
         printf("%s😔 Mais sorte na próxima vez! 😔%s\n", GRAY, RESET);
-        printf("A palavra era: %s%s%s\n\n", BOLD, game->target_word, RESET);
-        // Em caso de derrota, não oferece salvamento
+        printf("A palavra era: %s%s%s\n\n", BOLD, palavra, RESET);
     }
 
+    // Oferece opção para salvar o resultado (derrotas também entram nas estatísticas)
+    printf("Deseja salvar o resultado? (S/N): ");
+    char c = toupper(get_char());  // Converte para maiúscula
+
+    if (c == 'S') {
+        // Salva no arquivo JSON com tentativas, dicas e desfecho
+        if (salvar_resultado_json(game)) printf("\nResultado salvo com sucesso!\n");
+        else printf("\n%sNão foi possível gravar %s.%s\n", GRAY, RESULTADOS_ARQUIVO, RESET);
+    }
+    // Se escolher 'N' ou qualquer outra tecla, não salva
+
     // Aguarda input para retornar ao menu principal
     printf("Pressione qualquer tecla para retornar ao menu...");
     get_char();
@@ -850,14 +835,16 @@ void display_game_over(GameState* game, Difficulty dificuldade) {
     Retorna string com palpite ou NULL se jogo foi pausado
 */
 char* get_guess_with_pause(GameState* game) {
-    static char guess[WORD_LENGTH + 1];  // Buffer estático para armazenar palpite
+    static char guess[PALAVRA_MAX + 1];  // Buffer estático para armazenar palpite
+    static char aviso[256];              // Mensagem da dica (com cores), exibida no quadro
+    static char painel[METRICAS_N * 128 + 64]; // Métricas da tecla de depuração ('?')
     char input;                          // Caractere atual digitado pelo usuário
     int pos = 0;                        // Posição atual no buffer de entrada
+    const char* mensagem = NULL;        // Mensagem exibida acima do prompt até a próxima tecla
     time_t last_update = time(NULL);    // Timestamp da última atualização de tela
     
-    // Solicita entrada do usuário
-    printf("Digite seu palpite: ");
-    fflush(stdout);  // Força impressão imediata na tela
+    // Desenha a tela com o prompt de entrada
+    desenhar_jogo(game, guess, pos, mensagem);
     
     while (1) {
         // Atualiza a tela a cada segundo se o timer de dicas estiver ativo
@@ -867,92 +854,91 @@ char* get_guess_with_pause(GameState* game) {
             int remaining = HINT_DELAY - (int)(now - game->last_hint_time);
             // CORREÇÃO: Verifica se ainda há tempo restante OU se já passou do tempo limite
             if (remaining != (int)(last_update - game->last_hint_time) - HINT_DELAY) {
-                // Redesenha completamente a tela com o timer atualizado
-                display_game_board(game);
-                display_keyboard(game);
-                printf("Digite seu palpite: ");
-                // Reimprime caracteres já digitados pelo usuário
-                for (int i = 0; i < pos; i++) {
-                    printf("%c", guess[i]);
-                }
-                fflush(stdout);  // Garante que tudo seja exibido imediatamente
+                // Novo quadro com o timer atualizado: só a barra e os segundos mudam
+                desenhar_jogo(game, guess, pos, mensagem);
             }
             last_update = now;  // Atualiza timestamp da última atualização
         }
         
-        // Verifica se há input disponível do teclado
-        if (kbhit()) {
+        // Bloqueia até uma tecla ou a próxima virada do timer de dicas (sem timer:
+        // espera indefinidamente, sem acordar a CPU)
+        if (esperar_tecla(prazo_timer_dica(game))) {
             input = get_char();  // Obtém caractere digitado
+            mensagem = NULL;     // Qualquer tecla dispensa a mensagem anterior
             
             // Processa Enter/Return - finaliza entrada ou executa comandos
             if (input == '\n' || input == '\r') {
-                if (pos == WORD_LENGTH) {
-                    // Palpite completo com 5 letras - finaliza entrada
+                if (pos == game->letras) {
+                    // Palpite completo - finaliza entrada
                     guess[pos] = '\0';  // Adiciona terminador de string
-                    printf("\n");
                     return guess;
                 } else if (pos == 1 && (guess[0] == 'P' || guess[0] == 'p')) {
                     // Comando de pausa - abre menu de pausa
-                    printf("\n");
                     if (handle_pause_menu(game)) {
                         return NULL;  // Retorna NULL se jogo foi encerrado
                     }
-                    // Retorna ao jogo - redesenha tela e reseta entrada
-                    display_game_board(game);
-                    display_keyboard(game);
+                    // Retorna ao jogo - reseta entrada (o menu limpou a tela: quadro completo)
                     pos = 0;
-                    printf("Digite seu palpite: ");
-                    fflush(stdout);
                 } else if (pos == 1 && (guess[0] == 'H' || guess[0] == 'h')) {
                     // Comando de dica - tenta usar uma dica
-                    printf("\n");
-                    if (can_use_hint(game)) {
-                        use_hint(game);  // Usa dica se disponível
+                    time_t agora = time(NULL);
+                    if (can_use_hint(game, agora)) {
+                        int hint_pos = use_hint(game, agora);  // Usa dica se disponível
+                        gravacao_dica(&gravacao, 0, agora, hint_pos < 0 ? GRAVACAO_DICA_SEM_POSICAO : hint_pos);
+                        if (hint_pos < 0) {
+                            snprintf(aviso, sizeof(aviso), "Todas as letras disponíveis já foram reveladas ou acertadas!");
+                        } else {
+                            // A letra revelada também aparece em azul no tabuleiro
+                            snprintf(aviso, sizeof(aviso), "%sDica revelada!%s Letra na posição %d: %s%c%s",
+                                     BLUE, RESET, hint_pos + 1, BOLD, letra_secreta(game, hint_pos), RESET);
+                            salvar_partida(game);  // A dica usada (e o intervalo) vale na partida salva
+                        }
                     } else {
                         // Informa por que a dica não pode ser usada
-                        time_t now = time(NULL);
-                        int remaining = HINT_DELAY - (int)(now - game->last_hint_time);
+                        gravacao_dica(&gravacao, 0, agora, GRAVACAO_DICA_INDISPONIVEL);
+                        int remaining = HINT_DELAY - (int)(agora - game->last_hint_time);
                         if (game->hints_used >= MAX_HINTS) {
-                            printf("Você já usou todas as %d dicas disponíveis!\n", MAX_HINTS);
+                            snprintf(aviso, sizeof(aviso), "Você já usou todas as %d dicas disponíveis!", MAX_HINTS);
                         } else if (remaining > 0) {
-                            printf("Aguarde %d segundos para usar outra dica.\n", remaining);
+                            snprintf(aviso, sizeof(aviso), "Aguarde %d segundos para usar outra dica.", remaining);
                         } else {
-                            printf("Dica disponível! Tente novamente.\n");
+                            snprintf(aviso, sizeof(aviso), "Dica disponível! Tente novamente.");
                         }
-                        printf("Pressione qualquer tecla para continuar...");
-                        get_char();  // Aguarda confirmação do usuário
                     }
-                    // Redesenha tela e reseta entrada após usar/tentar usar dica
-                    display_game_board(game);
-                    display_keyboard(game);
+                    mensagem = aviso;
                     pos = 0;
-                    printf("Digite seu palpite: ");
-                    fflush(stdout);
                 } else {
                     // Entrada inválida - solicita novo palpite
-                    printf("\nPalpite deve ter exatamente 5 letras. Tente novamente: ");
-                    fflush(stdout);
+                    snprintf(aviso, sizeof(aviso), "Palpite deve ter exatamente %d letras. Tente novamente.", game->letras);
+                    mensagem = aviso;
                     pos = 0;  // Reseta posição para nova entrada
                 }
+            } else if (input == '?') {
+                // Tecla de depuração: liga as métricas ou mostra os números até agora
+                if (!metricas_ativas) {
+                    metricas_ativar();
+                    snprintf(painel, sizeof(painel), "Métricas ligadas: pressione ? de novo para ver os números.");
+                } else {
+                    size_t n = (size_t)snprintf(painel, sizeof(painel), "%sMétricas%s (? atualiza):\n", BOLD, RESET);
+                    n += metricas_formatar(painel + n, sizeof(painel) - n);
+                    if (painel[n - 1] == '\n') painel[n - 1] = '\0';  // desenhar_jogo já pula a linha
+                }
+                mensagem = painel;
             } else if (input == '\b' || input == 127) { // Processa Backspace
                 if (pos > 0) {
                     pos--;  // Remove último caractere do buffer
-                    printf("\b \b");  // Apaga caractere da tela (volta, espaço, volta)
-                    fflush(stdout);
                 }
-            } else if (isalpha(input) && pos < WORD_LENGTH) {
-                // Adiciona letra válida ao palpite (apenas letras, máximo 5)
+            } else if (isalpha(input) && pos < game->letras) {
+                // Adiciona letra válida ao palpite (apenas letras, até o tamanho da palavra)
                 guess[pos] = toupper(input);  // Converte para maiúscula
-                printf("%c", guess[pos]);     // Exibe na tela
-                fflush(stdout);
                 pos++;  // Avança posição no buffer
             }
             // Ignora outros caracteres não-alfabéticos ou quando buffer está cheio
-        } else {
-            // Pequeno delay para não consumir CPU desnecessariamente
-            // Evita loop infinito que sobrecarregaria o processador
-            sleep_ms(100);  // Pausa de 100 milissegundos
+            
+            // Novo quadro: em geral só a letra digitada (ou apagada) é enviada
+            desenhar_jogo(game, guess, pos, mensagem);
         }
+        // Prazo esgotado: o início do laço redesenha o timer
     }
 }
 
@@ -973,7 +959,7 @@ char get_char(void) {
     
     Temporariamente muda modo do terminal para entrada segura de números
     
-    Retorna número válido entre 1 e 3 escolhido pelo usuário
+    Retorna número válido entre 1 e 4 escolhido pelo usuário
 */
 int get_pause_choice_robust(void) {
     #ifndef _WIN32
@@ -986,15 +972,15 @@ int get_pause_choice_robust(void) {
     char input[10];     // Buffer para armazenar entrada do usuário (tamanho generoso)
     int choice = -1;    // Inicializa com valor inválido para entrar no loop
     
-    // Loop até obter escolha válida entre 1 e 3
-    while (choice < 1 || choice > 3) {
-        printf("Digite sua escolha (1-3): ");
+    // Loop até obter escolha válida entre 1 e 4
+    while (choice < 1 || choice > 4) {
+        printf("Digite sua escolha (1-4): ");
         fflush(stdout);  // Força exibição imediata do prompt
         
         // Lê linha completa de entrada do usuário
         if (fgets(input, sizeof(input), stdin)) {
             choice = atoi(input);  // Converte string para inteiro
-            if (choice < 1 || choice > 3) {
+            if (choice < 1 || choice > 4) {
                 printf("Opção inválida! ");  // Informa erro sem quebrar linha
             }
         }
@@ -1031,25 +1017,43 @@ int handle_pause_menu(GameState* game) {
             case 1: // Opção: Continuar jogo atual
                 return 0; // Retorna 0 para voltar direto ao jogo sem mensagens
                 
-            case 2: // Opção: Reiniciar partida atual
-                // Reinicializa jogo com mesma dificuldade selecionada
-                init_game(game, game->difficulty);
+            case 2: { // Opção: Reiniciar partida atual
+                // Reinicializa jogo com mesma dificuldade e número de letras
+                uint64_t semente = proxima_semente();
+                gravacao_fim(&gravacao, 0, game, FIM_ABANDONADA);
+                init_game_letras(game, game->motor, game->difficulty, game->letras, semente);
+                gravacao_nova(&gravacao, 0, semente, game);
+                salvar_partida(game);  // A partida salva passa a ser a nova
                 clear_screen();
                 printf("\n%sJogo reiniciado!%s\n", GREEN, RESET);
                 printf("Nova palavra selecionada. Boa sorte!\n");
                 printf("Pressione qualquer tecla para continuar...");
                 get_char();  // Aguarda confirmação antes de continuar
                 return 0;    // Retorna 0 para continuar com novo jogo
+            }
                 
             case 3: // Opção: Desistir da partida
                 clear_screen();
                 // Revela a palavra-alvo com formatação especial
+                char palavra[PALAVRA_MAX + 1];
+                palavra_secreta(game, palavra);
                 printf("\n%s😔 Que pena! A palavra era: %s%s%s%s\n", 
-                       GRAY, BOLD, game->target_word, RESET, RESET);
+                       GRAY, BOLD, palavra, RESET, RESET);
                 printf("Não desista! Tente novamente!\n");
                 printf("Pressione qualquer tecla para voltar ao menu...");
+                descartar_partida_salva();  // Desistência encerra a partida
+                gravacao_fim(&gravacao, 0, game, FIM_ABANDONADA);
                 get_char();  // Aguarda confirmação antes de sair
                 return 1;    // Retorna 1 para sinalizar saída ao menu principal
+
+            case 4: // Opção: Salvar e voltar ao menu (retomada em "Jogar")
+                salvar_partida(game);
+                gravacao_fim(&gravacao, 0, game, FIM_SALVA);
+                clear_screen();
+                printf("\n%sPartida salva!%s Escolha \"Jogar\" no menu para continuar de onde parou.\n", GREEN, RESET);
+                printf("Pressione qualquer tecla para voltar ao menu...");
+                get_char();
+                return 1;
                 
             default:
                 // Caso de erro inesperado (não deveria acontecer devido à validação)
@@ -1059,23 +1063,6 @@ int handle_pause_menu(GameState* game) {
     }
 }
 
-/*
-   Verifica se uma posição específica da palavra já foi descoberta
-   
-   Analisa tentativas anteriores para ver se a posição tem feedback verde
-   
-   Retorna 1 se posição foi resolvida, 0 caso contrário
-*/
-int is_position_solved(GameState* game, int position) {
-   // Percorre todas as tentativas já realizadas pelo jogador
-   for (int attempt = 0; attempt < game->current_attempt; attempt++) {
-       if (game->feedback[attempt][position] == 2) { // Verde = letra correta na posição correta
-           return 1;  // Posição já foi descoberta em tentativa anterior
-       }
-   }
-   return 0;  // Posição ainda não foi descoberta
-}
-
 /*
     Obtém escolha do usuário no menu principal
 
@@ -1115,78 +1102,793 @@ int get_difficulty_choice(void) {
 }
 
 /*
-   Verifica se uma palavra existe nas listas de palavras válidas
-   
-   Converte palavra para maiúsculas e busca nas listas apropriadas
-   
-   Retorna 1 se palavra existe, 0 caso contrário
+    Pergunta o número de letras quando há listas de outros comprimentos
+    
+    Retorna o número de letras escolhido (WORD_LENGTH se não há alternativas
+    ou a entrada é inválida)
 */
-int check_word_exists(GameState* game, const char* word) {
-   char upper_word[WORD_LENGTH + 1];  // Buffer para palavra em maiúsculas
-   
-   // Converte toda a palavra para maiúsculas para comparação padronizada
-   for (int i = 0; i < WORD_LENGTH; i++) {
-       upper_word[i] = toupper(word[i]);
+int get_length_choice(void) {
+   int alternativas = 0;
+   for (int letras = PALAVRA_MIN; letras <= PALAVRA_MAX; letras++) {
+       if (letras != WORD_LENGTH && motor_tem_comprimento(&motor, letras)) alternativas++;
    }
-   upper_word[WORD_LENGTH] = '\0';  // Adiciona terminador de string
+   if (alternativas == 0) return WORD_LENGTH;  // Só o modo clássico: não pergunta
 
-   // Verifica primeiro na lista normal de palavras
-   for (int i = 0; i < WORD_COUNT; i++) {
-       if (strcmp(upper_word, word_list[i]) == 0) {
-           return 1;  // Palavra encontrada na lista normal
+   clear_screen();
+   printf("\n%s=== NÚMERO DE LETRAS ===%s\n\n", BOLD, RESET);
+   for (int letras = PALAVRA_MIN; letras <= PALAVRA_MAX; letras++) {
+       if (motor_tem_comprimento(&motor, letras)) {
+           printf("  %d. %d letras%s\n", letras, letras, letras == WORD_LENGTH ? " (clássico)" : "");
        }
    }
+   printf("\n  Selecione o número de letras: ");
 
-   // Só verifica na lista difícil se estiver no modo difícil
-   if (game->difficulty == HARD) {
-       for (int i = 0; i < HARD_WORD_COUNT; i++) {
-           if (strcmp(upper_word, hard_word_list[i]) == 0) {
-               return 1;  // Palavra encontrada na lista difícil
-           }
-       }
-   }
+   int letras = get_char() - '0';  // Converte caractere para número inteiro
+   return motor_tem_comprimento(&motor, letras) ? letras : WORD_LENGTH;
+}
+
+/*
+    Carrega as listas dos comprimentos alternativos (palavras_4.txt,
+    palavras_6.txt, ...); arquivos ausentes apenas deixam o modo indisponível
+*/
+void carregar_comprimentos(void) {
+    for (int letras = PALAVRA_MIN; letras <= PALAVRA_MAX; letras++) {
+        if (letras == WORD_LENGTH) continue;
+        char arquivo[32];
+        snprintf(arquivo, sizeof(arquivo), "palavras_%d.txt", letras);
+        CargaLista carga;
+        if (motor_carregar_comprimento(&motor, letras, arquivo, &carga) > 0) {
+            printf("Carregadas %d palavras de %d letras do arquivo: %s (%.2f ms)\n",
+                   carga.palavras, letras, arquivo, carga.segundos * 1000.0);
+        }
+    }
+}
 
-   return 0;  // Palavra não encontrada em nenhuma lista
+/*
+    Carrega as listas de palavras pelo motor e informa o resultado ao usuário
+    (quantidade e tempo de cada arquivo)
+    @param paralelo: 1 para carregar as duas listas ao mesmo tempo
+*/
+void carregar_listas(int paralelo) {
+    CargaLista cargas[2];
+    double inicio = agora_segundos();
+    motor_carregar(&motor, arquivo_normal, arquivo_dificil, paralelo, cargas);
+    double total = agora_segundos() - inicio;
+
+    for (int i = 0; i < 2; i++) {
+        if (cargas[i].palavras < 0) {
+            printf("Erro ao abrir arquivo: %s\n", cargas[i].arquivo);
+        } else {
+            printf("Carregadas %d palavras do arquivo: %s (%.2f ms)\n",
+                   cargas[i].palavras, cargas[i].arquivo, cargas[i].segundos * 1000.0);
+            printf("  %d duplicada(s) removida(s), %d com acento normalizada(s), %d linha(s) descartada(s)\n",
+                   cargas[i].duplicadas, cargas[i].com_acento, cargas[i].descartadas);
+        }
+    }
+    printf("Listas carregadas em %.2f ms%s\n", total * 1000.0, paralelo ? " (em paralelo)" : "");
 }
 
 /*
-   Verifica se o jogador pode usar uma dica no momento atual
-   
-   Checa limite máximo de dicas e tempo de espera entre dicas
-   
-   Retorna 1 se pode usar dica, 0 caso contrário
+    Carrega as listas extras (--lista nome=arquivo), aceitas como tentativa em
+    qualquer dificuldade
+    @return: 1 se todas foram carregadas
 */
-int can_use_hint(GameState* game) {
-   if (game->hints_used >= MAX_HINTS) return 0;  // Já usou todas as dicas disponíveis
-   if (game->hints_used == 0) return 1;          // Primeira dica sempre disponível
-   
-   time_t now = time(NULL);  // Obtém timestamp atual
-   return (now - game->last_hint_time) >= HINT_DELAY;  // Verifica se passou tempo mínimo
+int carregar_listas_extras(void) {
+    for (int i = 0; i < n_listas_extras; i++) {
+        CargaLista carga;
+        if (motor_carregar_lista(&motor, listas_extras[i].nome, listas_extras[i].arquivo, &carga) < 0) {
+            printf("Erro ao carregar lista %s: %s\n", listas_extras[i].nome, listas_extras[i].arquivo);
+            return 0;
+        }
+        printf("Lista %s: %d palavras do arquivo %s (%.2f ms)\n",
+               listas_extras[i].nome, carga.palavras, carga.arquivo, carga.segundos * 1000.0);
+    }
+    return 1;
+}
+
+/*
+    Interpreta uma opção --lista nome=arquivo
+    "normal" e "dificil" trocam o arquivo de uma lista padrão; outro nome cria
+    uma lista extra
+    @return: 1 se a opção é válida
+*/
+int registrar_lista(char* opcao) {
+    char* igual = strchr(opcao, '=');
+    if (!igual || igual == opcao || !igual[1] || (size_t)(igual - opcao) >= MOTOR_NOME_LISTA) {
+        printf("Opção inválida: --lista %s (use nome=arquivo)\n", opcao);
+        return 0;
+    }
+    *igual = '\0';
+    if (strcmp(opcao, "normal") == 0) {
+        arquivo_normal = igual + 1;
+    } else if (strcmp(opcao, "dificil") == 0) {
+        arquivo_dificil = igual + 1;
+    } else if (n_listas_extras < MOTOR_MAX_LISTAS - 2) {
+        listas_extras[n_listas_extras].nome = opcao;
+        listas_extras[n_listas_extras].arquivo = igual + 1;
+        n_listas_extras++;
+    } else {
+        printf("Listas demais: no máximo %d listas extras\n", MOTOR_MAX_LISTAS - 2);
+        return 0;
+    }
+    return 1;
+}
+
+/*
+    Tenta preparar o motor a partir do dicionário compilado (sem analisar os .txt)
+    @return: Estado do artefato; qualquer valor diferente de DICIONARIO_OK exige os .txt
+*/
+DicionarioEstado abrir_dicionario_compilado(void) {
+    double inicio = agora_segundos();
+    DicionarioEstado estado = dicionario_abrir(&motor, DICIONARIO_ARQUIVO, arquivo_normal, arquivo_dificil);
+    double duracao = agora_segundos() - inicio;
+
+    if (estado == DICIONARIO_OK) {
+        printf("Dicionário compilado %s: %d + %d palavras (%.2f ms)\n",
+               DICIONARIO_ARQUIVO, motor.normal->n, motor.dificil->n, duracao * 1000.0);
+    } else if (estado != DICIONARIO_AUSENTE) {
+        printf("Dicionário compilado %s %s; usando os arquivos .txt\n",
+               DICIONARIO_ARQUIVO, dicionario_estado_nome(estado));
+    }
+    return estado;
+}
+
+/*
+    Modo --compilar-dicionario: grava as listas carregadas dos .txt e o índice
+    pronto em um artefato binário, usado nas próximas execuções
+    @return: Código de saída do processo
+*/
+int run_compilar_dicionario(const char* caminho) {
+    if (!dicionario_compilar(&motor, caminho, arquivo_normal, arquivo_dificil)) {
+        printf("Erro ao gravar dicionário compilado: %s\n", caminho);
+        return 1;
+    }
+    printf("Dicionário compilado gravado em %s (%d + %d palavras, índice com %u slots)\n",
+           caminho, motor.normal->n, motor.dificil->n, motor.index.mask + 1);
+    return 0;
+}
+
+/*
+    Modo --gerar-tabela: calcula (em paralelo) ou reaproveita a tabela de padrões
+    de todas as palavras x todas as palavras e grava o cache em `caminho`
+    @return: Código de saída do processo
+*/
+int run_gerar_tabela(const char* caminho) {
+    uint32_t n;
+    uint32_t* todas = montar_lista_completa(&motor, &n);
+    if (!todas) {
+        printf("Erro: memória insuficiente\n");
+        return 1;
+    }
+
+    int threads = tabela_threads_padrao();
+    double inicio = agora_segundos();
+    PatternTable tabela;
+    if (!tabela_abrir(&tabela, todas, n, caminho, threads)) {
+        printf("Erro: memória insuficiente para a tabela %ux%u\n", n, n);
+        free(todas);
+        return 1;
+    }
+    double duracao = agora_segundos() - inicio;
+
+    printf("Tabela de padrões %ux%u (%.1f MB) %s em %.2fs [kernel %s, %d threads]\n",
+           n, n, (double)n * n / (1024.0 * 1024.0),
+           tabela.from_cache ? "carregada do cache" : "calculada",
+           duracao, feedback_kernel_name(), threads);
+    printf("Arquivo: %s\n", caminho);
+
+    tabela_fechar(&tabela);
+    free(todas);
+    return 0;
+}
+
+/*
+    Modo --resolver: o próprio motor joga uma partida completa
+    Usa init_game/check_word_exists/process_guess como um jogador humano e
+    alimenta o resolvedor com o feedback calculado pelo jogo
+    A tabela de padrões é usada se o cache (--gerar-tabela) já existir
+    @return: Código de saída do processo
+*/
+int run_resolver(Difficulty difficulty) {
+    uint32_t n;
+    uint32_t* todas = montar_lista_completa(&motor, &n);
+    if (!todas) {
+        printf("Erro: memória insuficiente\n");
+        return 1;
+    }
+
+    PatternTable tabela;
+    int tem_tabela = tabela_carregar(&tabela, todas, n, TABELA_ARQUIVO);
+    ResolverBase base;
+    if (!resolver_base_iniciar(&base, todas, n, tem_tabela ? &tabela : NULL)) {
+        printf("Erro: memória insuficiente\n");
+        free(todas);
+        return 1;
+    }
+
+    // Faixas de índices: lista normal = [0, normal->n), difícil = [normal->n, n)
+    uint32_t cand_ini = 0, cand_fim = (uint32_t)motor.normal->n, palp_fim = (uint32_t)motor.normal->n;
+    if (difficulty == HARD) {
+        cand_ini = (uint32_t)motor.normal->n;    // Alvo sorteado da lista difícil
+        cand_fim = n;
+        palp_fim = n;                       // No modo difícil as duas listas são aceitas
+    }
+
+    GameState game;
+    Resolver resolver;
+    init_game(&game, &motor, difficulty, proxima_semente());
+    if (!resolver_iniciar(&resolver, &base, cand_ini, cand_fim, 0, palp_fim)) {
+        printf("Erro: memória insuficiente\n");
+        resolver_base_liberar(&base);
+        if (tem_tabela) tabela_fechar(&tabela);
+        free(todas);
+        return 1;
+    }
+
+    printf("\n%s=== RESOLVEDOR ===%s [%s] %d tentativas, %u candidatas, %s\n\n",
+           BOLD, RESET, diff_names[difficulty], game.max_attempts, resolver.n,
+           tem_tabela ? "tabela de padrões (mmap)" : "kernel de feedback");
+
+    while (!game.game_over) {
+        double inicio = agora_segundos();
+        uint32_t palpite = resolver_escolher(&resolver, game.max_attempts - game.current_attempt);
+        double duracao = agora_segundos() - inicio;
+        if (palpite == RESOLVER_NENHUM) {
+            printf("Nenhuma candidata compatível com o feedback recebido.\n");
+            break;
+        }
+
+        char texto[WORD_LENGTH + 1];
+        unpack_word(todas[palpite], texto);
+        if (!check_word_exists(&game, texto)) {
+            printf("Palpite %s rejeitado pelo dicionário.\n", texto);
+            break;
+        }
+        process_guess(&game, texto);
+
+        // Feedback calculado pelo próprio jogo alimenta o filtro de candidatas
+        int fb[WORD_LENGTH];
+        feedback_tentativa(&game, game.current_attempt - 1, fb);
+        resolver_filtrar(&resolver, palpite, (uint8_t)game.padroes[game.current_attempt - 1]);
+
+        printf("  %d. ", game.current_attempt);
+        for (int j = 0; j < WORD_LENGTH; j++) {
+            const char* color = fb[j] == 2 ? GREEN : (fb[j] == 1 ? YELLOW : GRAY);
+            printf("%s %c %s", color, texto[j], RESET);
+        }
+        printf("  %u candidata(s) restante(s) | escolha em %.1f ms\n", resolver.n, duracao * 1000.0);
+    }
+
+    char palavra[PALAVRA_MAX + 1];
+    palavra_secreta(&game, palavra);
+    printf("\n%s %s%s%s em %d tentativa(s)\n",
+           game.won ? "Resolvido:" : "Não resolvido:", BOLD, palavra, RESET, game.current_attempt);
+
+    resolver_liberar(&resolver);
+    resolver_base_liberar(&base);
+    if (tem_tabela) tabela_fechar(&tabela);
+    free(todas);
+    return game.won ? 0 : 2;
+}
+
+/*
+    Modo --lote: o resolvedor joga contra TODAS as palavras-alvo
+    - Fácil e Médio: cada palavra de palavras.txt (7 e 6 tentativas)
+    - Difícil: cada palavra de palavras_dificeis.txt (5 tentativas)
+    Gera o relatório por palavra em CSV e imprime as distribuições
+    @return: Código de saída do processo
+*/
+int run_lote(int threads, const char* relatorio) {
+    uint32_t n;
+    uint32_t* todas = montar_lista_completa(&motor, &n);
+    if (!todas) {
+        printf("Erro: memória insuficiente\n");
+        return 1;
+    }
+
+    // Milhares de jogos: compensa calcular a tabela se ainda não houver cache
+    PatternTable tabela;
+    int tem_tabela = tabela_abrir(&tabela, todas, n, TABELA_ARQUIVO, threads);
+
+    ResolverBase base;
+    Lote lote;
+    if (!resolver_base_iniciar(&base, todas, n, tem_tabela ? &tabela : NULL)) {
+        printf("Erro: memória insuficiente\n");
+        if (tem_tabela) tabela_fechar(&tabela);
+        free(todas);
+        return 1;
+    }
+    lote_iniciar(&lote, &base);
+
+    uint32_t normais = (uint32_t)motor.normal->n;
+    LoteModo facil   = { diff_names[EASY],   max_attempts_for(EASY),   0, normais, 0, normais };
+    LoteModo medio   = { diff_names[MEDIUM], max_attempts_for(MEDIUM), 0, normais, 0, normais };
+    LoteModo dificil = { diff_names[HARD],   max_attempts_for(HARD),   normais, n, 0, n };
+    lote_adicionar_modo(&lote, &facil);
+    lote_adicionar_modo(&lote, &medio);
+    lote_adicionar_modo(&lote, &dificil);
+
+    printf("Avaliando %u palavras-alvo com %d thread(s)...\n", n + normais, threads);
+    int ok = lote_executar(&lote, threads);
+    if (ok) {
+        lote_imprimir_resumo(&lote);
+        if (lote_gravar_relatorio(&lote, relatorio)) {
+            printf("Relatório por palavra: %s\n", relatorio);
+        } else {
+            printf("Erro ao gravar relatório: %s\n", relatorio);
+        }
+    } else {
+        printf("Erro: memória insuficiente para o lote\n");
+    }
+
+    lote_liberar(&lote);
+    resolver_base_liberar(&base);
+    if (tem_tabela) tabela_fechar(&tabela);
+    free(todas);
+    return ok ? 0 : 1;
+}
+
+/*
+    Modo --reproduzir: repete um log gravado com --gravar contra o motor, sem
+    terminal, `vezes` seguidas (benchmark com tráfego real) e confere cada
+    resultado com o gravado (teste de regressão)
+    Retorna 0 se não houve divergência
+*/
+int run_reproduzir(const char* arquivo, int vezes) {
+    size_t tamanho;
+    unsigned char* dados = gravacao_carregar(arquivo, &tamanho);
+    if (!dados) {
+        printf("Erro: %s não existe ou não é um log de partidas\n", arquivo);
+        return 1;
+    }
+
+    Reproducao r;
+    memset(&r, 0, sizeof(r));
+    int completo = 1;
+    double inicio = agora_segundos();
+    for (int i = 0; i < vezes && completo; i++) {
+        completo = gravacao_reproduzir(&motor, dados, tamanho, &r, i == 0 ? 10 : 0); // Detalha só a 1ª passada
+    }
+    double segundos = agora_segundos() - inicio;
+    free(dados);
+
+    printf("Log: %s (%.1f KB), repetido %d vez(es)\n", arquivo, tamanho / 1024.0, vezes);
+    printf("  %llu evento(s): %llu partida(s), %llu tentativa(s) (+%llu recusada(s)), %llu dica(s), %llu vitória(s)\n",
+           (unsigned long long)r.eventos, (unsigned long long)r.partidas, (unsigned long long)r.tentativas,
+           (unsigned long long)r.rejeitadas, (unsigned long long)r.dicas, (unsigned long long)r.vitorias);
+    printf("  Tempo: %.3f s | %.0f tentativas/s | %.0f eventos/s\n", segundos,
+           segundos > 0 ? r.tentativas / segundos : 0.0, segundos > 0 ? r.eventos / segundos : 0.0);
+    printf("  Média por fase: nova partida %.0f ns | validação %.0f ns | tentativa %.0f ns | dica %.0f ns\n",
+           r.partidas ? (double)r.ns_nova / r.partidas : 0.0,
+           r.tentativas + r.rejeitadas ? (double)r.ns_validacao / (r.tentativas + r.rejeitadas) : 0.0,
+           r.tentativas ? (double)r.ns_tentativa / r.tentativas : 0.0,
+           r.dicas ? (double)r.ns_dica / r.dicas : 0.0);
+    if (r.cortados) printf("  %llu byte(s) finais ignorados (evento incompleto)\n", (unsigned long long)(r.cortados / (uint64_t)vezes));
+    if (!completo) printf("  Log inválido: leitura interrompida\n");
+    printf("  Divergências: %llu\n", (unsigned long long)r.divergencias);
+    return completo && r.divergencias == 0 ? 0 : 1;
+}
+
+// ============================================================================
+// MICRO-BENCHMARKS (--bench)
+// ============================================================================
+
+#define BENCH_RESULTADOS_ARQUIVO "bench_resultados.json" // Histórico sintético (apagado no fim)
+#define BENCH_RESULTADOS_PARTIDAS 250000                 // Partidas no histórico sintético (~35 MB)
+
+#ifdef _WIN32
+    #define SAIDA_NULA "NUL"
+#else
+    #define SAIDA_NULA "/dev/null"
+#endif
+
+// Contexto dos casos de interface: uma partida no meio e a saída descartada
+typedef struct {
+    GameState game;
+    FILE* nulo;
+    volatile uint64_t sumidouro;
+} ContextoTela;
+
+static void bench_tabuleiro(void* contexto, uint64_t iteracoes) {
+    ContextoTela* c = contexto;
+    for (uint64_t i = 0; i < iteracoes; i++) display_game_board(&c->game);
+}
+
+static void bench_teclado(void* contexto, uint64_t iteracoes) {
+    ContextoTela* c = contexto;
+    for (uint64_t i = 0; i < iteracoes; i++) {
+        tela_limpar(&tela);
+        display_keyboard(&c->game);
+    }
+}
+
+// Quadro completo como em desenhar_jogo, com o prompt mudando a cada tecla (só a diferença é enviada)
+static void bench_quadro(void* contexto, uint64_t iteracoes) {
+    ContextoTela* c = contexto;
+    const char digitado[] = "CASAS";
+    for (uint64_t i = 0; i < iteracoes; i++) {
+        display_game_board(&c->game);
+        display_keyboard(&c->game);
+        tela_printf(&tela, "Digite seu palpite: %.*s", (int)(i % 6), digitado);
+        c->sumidouro += tela_apresentar(&tela, fileno(c->nulo));
+    }
+}
+
+static void bench_resultados(void* contexto, uint64_t iteracoes) {
+    ContextoTela* c = contexto;
+    for (uint64_t i = 0; i < iteracoes; i++) c->sumidouro += imprimir_resultados(c->nulo, BENCH_RESULTADOS_ARQUIVO);
+}
+
+// Sem o resumo: a tela relê o histórico inteiro (primeira abertura ou resumo perdido)
+static void bench_resultados_sem_resumo(void* contexto, uint64_t iteracoes) {
+    ContextoTela* c = contexto;
+    for (uint64_t i = 0; i < iteracoes; i++) {
+        remove(BENCH_RESULTADOS_ARQUIVO RESULTADOS_SUFIXO_RESUMO);
+        c->sumidouro += imprimir_resultados(c->nulo, BENCH_RESULTADOS_ARQUIVO);
+    }
+}
+
+// Histórico sintético (BENCH_RESULTADOS_ARQUIVO) com `partidas` registros variados, gravado em lotes
+static int gerar_resultados_sinteticos(int partidas) {
+    remove(BENCH_RESULTADOS_ARQUIVO);
+    remove(BENCH_RESULTADOS_ARQUIVO RESULTADOS_SUFIXO_RESUMO);
+    GravadorResultados g;
+    if (!resultados_abrir(&g, BENCH_RESULTADOS_ARQUIVO, RESULTADOS_LOTE_PADRAO, RESULTADOS_INTERVALO_PADRAO, 0)) return 0;
+
+    Aleatorio rng;
+    aleatorio_semear(&rng, 2024);
+    int ok = 1;
+    for (int i = 0; i < partidas && ok; i++) {
+        RegistroResultado r;
+        memset(&r, 0, sizeof(r));
+        r.quando = 1700000000 + (int64_t)i * 60;
+        unpack_word(motor.normal->palavras[aleatorio_limite(&rng, (uint32_t)motor.normal->n)], r.palavra);
+        r.letras = WORD_LENGTH;
+        r.dificuldade = (uint8_t)(EASY + aleatorio_limite(&rng, 4));
+        r.max_tentativas = (uint8_t)max_attempts_for((Difficulty)r.dificuldade);
+        r.tentativas = (uint8_t)(1 + aleatorio_limite(&rng, r.max_tentativas));
+        r.venceu = r.tentativas < r.max_tentativas || aleatorio_limite(&rng, 2);
+        r.dicas = (uint8_t)aleatorio_limite(&rng, MAX_HINTS + 1);
+        ok = resultados_gravar(&g, &r);
+    }
+    ok = resultados_descarregar(&g) && ok;
+    resultados_fechar(&g);
+    return ok;
+}
+
+/*
+    Modo --bench: micro-benchmarks do motor (bench.c), da composição da
+    tela de jogo (com o quadro enviado a uma saída nula) e da tela de
+    resultados sobre um histórico sintético grande
+    Escreve os resultados em `arquivo_json`; retorna 0 se tudo foi medido
+*/
+int run_bench(const char* arquivo_json) {
+    Bench b;
+    if (!bench_iniciar(&b, arquivo_json)) {
+        printf("Erro: não foi possível criar %s\n", arquivo_json);
+        return 1;
+    }
+    ContextoTela* c = calloc(1, sizeof(ContextoTela));
+    if (c) c->nulo = fopen(SAIDA_NULA, "w");
+    if (!c || !c->nulo || !tela_iniciar(&tela)) {
+        printf("Erro: não foi possível preparar a saída nula\n");
+        if (c && c->nulo) fclose(c->nulo);
+        free(c);
+        bench_concluir(&b);
+        return 1;
+    }
+
+    printf("Micro-benchmarks (mediana de %d repetições; ciclos: %s)\n", BENCH_REPETICOES,
+           b.fonte_ciclos ? b.fonte_ciclos : "indisponível");
+    bench_motor(&b, &motor, arquivo_normal);
+
+    // Tabuleiro no meio de uma partida: três tentativas e uma dica revelada
+    init_game(&c->game, &motor, MEDIUM, 2024);
+    for (int i = 0; i < 3; i++) {
+        char palavra[WORD_LENGTH + 1];
+        unpack_word(motor.normal->palavras[(i * 7919) % motor.normal->n], palavra);
+        process_guess(&c->game, palavra);
+    }
+    if (!c->game.game_over) use_hint(&c->game, time(NULL));
+    bench_medir(&b, "display_game_board", bench_tabuleiro, c);
+    bench_medir(&b, "display_keyboard", bench_teclado, c);
+    bench_medir(&b, "quadro_tela_nula", bench_quadro, c);
+
+    int ok = gerar_resultados_sinteticos(BENCH_RESULTADOS_PARTIDAS);
+    if (ok) {
+        bench_medir(&b, "display_results", bench_resultados, c);
+        bench_medir(&b, "display_results_sem_resumo", bench_resultados_sem_resumo, c);
+    } else {
+        printf("Erro: não foi possível gerar o histórico sintético\n");
+    }
+    remove(BENCH_RESULTADOS_ARQUIVO);
+    remove(BENCH_RESULTADOS_ARQUIVO RESULTADOS_SUFIXO_RESUMO);
+
+    tela_liberar(&tela);
+    fclose(c->nulo);
+    free(c);
+    ok = bench_concluir(&b) && ok;
+    printf("Resultados em %s\n", arquivo_json);
+    return ok ? 0 : 1;
+}
+
+// Imprime as métricas coletadas (--stats, registrado com atexit)
+void despejar_metricas(void) {
+    char texto[METRICAS_N * 128 + 1];
+    if (metricas_formatar(texto, sizeof(texto)) == 0) {
+        printf("Métricas: nenhuma medida\n");
+        return;
+    }
+    printf("Métricas:\n%s", texto);
+}
+
+// Abre o log de --gravar (modos que jogam partidas); 0 se não foi possível
+int abrir_gravacao(void) {
+    if (!arquivo_gravacao) return 1;
+    if (gravacao_abrir(&gravacao, arquivo_gravacao)) return 1;
+    printf("Erro: não foi possível gravar em %s\n", arquivo_gravacao);
+    return 0;
+}
+
+void fechar_gravacao(void) {
+    if (!gravacao.f) return;
+    gravacao_fechar(&gravacao);
+    printf("Gravação: %llu evento(s), %.1f KB em %s\n", (unsigned long long)gravacao.eventos,
+           gravacao.bytes / 1024.0, arquivo_gravacao);
+}
+
+/*
+    Modo --compactar-resultados: regrava o histórico só com as linhas válidas
+    e refaz o resumo por dificuldade a partir dele
+    Use com o jogo e o servidor parados (o arquivo é substituído)
+*/
+int run_compactar_resultados(const char* caminho) {
+    uint64_t mantidas = 0, descartadas = 0;
+    double inicio = agora_segundos();
+    if (!resultados_compactar(caminho, &mantidas, &descartadas)) {
+        printf("Erro: não foi possível compactar %s\n", caminho);
+        return 1;
+    }
+    ResumoResultados resumo;
+    resultados_carregar_resumo(caminho, &resumo);
+    printf("%s compactado em %.3fs: %llu partida(s) mantida(s), %llu linha(s) descartada(s)\n",
+           caminho, agora_segundos() - inicio, (unsigned long long)mantidas, (unsigned long long)descartadas);
+    for (int d = EASY; d <= DEMO; d++) {
+        const ResumoDificuldade* r = &resumo.dificuldades[d];
+        if (r->jogos > 0) {
+            printf("  %s: %llu jogo(s), %llu vitória(s), melhor sequência %u\n", resultados_nome_dificuldade(d),
+                   (unsigned long long)r->jogos, (unsigned long long)r->vitorias, r->melhor_sequencia);
+        }
+    }
+    return 0;
+}
+
+/*
+    Modo --historico: lista as partidas do histórico que passam pelos filtros
+    Sem --pagina, percorre o arquivo inteiro em páginas internas (memória
+    constante) e mostra o total; com --pagina N, só lê até o fim da página N
+*/
+int run_historico(int argc, char* argv[]) {
+    FiltroResultados filtro;
+    memset(&filtro, 0, sizeof(filtro));
+    filtro.resultado = -1;
+    const char* caminho = RESULTADOS_ARQUIVO;
+    long pagina = 0;                    // 0 = todas
+    int por_pagina = 20;
+
+    for (int i = 0; i < argc; i++) {
+        const char* valor = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--vitorias") == 0) {
+            filtro.resultado = 1;
+        } else if (strcmp(argv[i], "--derrotas") == 0) {
+            filtro.resultado = 0;
+        } else if (valor && strcmp(argv[i], "--dificuldade") == 0 && atoi(valor) >= EASY && atoi(valor) <= DEMO) {
+            filtro.dificuldade = atoi(argv[++i]);
+        } else if (valor && strcmp(argv[i], "--palavra") == 0 && strlen(valor) <= PALAVRA_MAX) {
+            for (int k = 0; valor[k]; k++) filtro.palavra[k] = (char)toupper((unsigned char)valor[k]);
+            i++;
+        } else if (valor && strcmp(argv[i], "--de") == 0 && ler_data(valor, 0, &filtro.desde)) {
+            i++;
+        } else if (valor && strcmp(argv[i], "--ate") == 0 && ler_data(valor, 1, &filtro.ate)) {
+            i++;
+        } else if (valor && strcmp(argv[i], "--pagina") == 0 && atol(valor) > 0) {
+            pagina = atol(argv[++i]);
+        } else if (valor && strcmp(argv[i], "--por-pagina") == 0 && atoi(valor) > 0) {
+            por_pagina = atoi(argv[++i]);
+        } else if (valor && strcmp(argv[i], "--arquivo") == 0) {
+            caminho = argv[++i];
+        } else {
+            printf("Opção inválida para --historico: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    RegistroResultado bloco[256];
+    if (pagina > 0) {
+        // Pula as páginas anteriores sem guardá-las e lê só a página pedida
+        if (por_pagina > 256) por_pagina = 256;
+        int n = resultados_consultar(caminho, &filtro, 0, (uint64_t)(pagina - 1) * (uint64_t)por_pagina,
+                                     bloco, por_pagina, NULL);
+        for (int i = 0; i < n; i++) print_registro(&bloco[i]);
+        printf("Página %ld: %d partida(s)\n", pagina, n);
+        return 0;
+    }
+
+    uint64_t inicio = 0, total = 0;
+    int n;
+    do {
+        n = resultados_consultar(caminho, &filtro, inicio, 0, bloco, 256, &inicio);
+        for (int i = 0; i < n; i++) print_registro(&bloco[i]);
+        total += (uint64_t)n;
+    } while (n == 256);
+    printf("%llu partida(s) encontrada(s)\n", (unsigned long long)total);
+    return 0;
 }
 
 /*
     Função principal do jogo - ponto de entrada da aplicação
     
     Inicializa sistema, carrega palavras e gerencia loop principal do menu
+    Opções de linha de comando:
+      --carregar-paralelo       (antes do modo) Carrega as listas de palavras em paralelo
+      --lista nome=arquivo      (antes do modo, repetível) Troca a lista normal/dificil ou
+                                adiciona uma lista extra de palavras aceitas
+      --fsync                   (antes do modo) fsync a cada gravação do histórico de resultados
+      --semente N               (antes do modo) Partidas repetíveis: a n-ésima partida usa a semente N+n
+      --gravar arquivo          (antes do modo) Grava as partidas (jogo ou servidor) em um log de eventos
+      --stats                   (antes do modo) Mede tentativas, validação, tela e histórico; imprime ao sair
+                                (no jogo, a tecla ? liga as métricas e mostra os números; no servidor, STATS)
+      --compilar-dicionario [arquivo]  Compila as listas e o índice em um artefato binário
+      --gerar-tabela [arquivo]  Gera/valida o cache da tabela de padrões e sai
+      --resolver [1-4]          O resolvedor joga uma partida (dificuldade padrão: 2)
+      --lote [threads] [csv]    O resolvedor joga contra todas as palavras e gera relatório
+      --servidor [endereco]     Hospeda partidas em um socket (porta, host:porta ou caminho Unix)
+                                e grava as partidas encerradas em resultados.json, em lotes;
+                                as partidas em andamento ficam em sessoes.sav (RESUME <id>)
+      --carga [endereco] [conexoes] [jogos]  Mede vazão e latência de um servidor
+      --reproduzir arquivo [vezes]  Repete um log de --gravar sem terminal, mede e confere os resultados
+      --bench [arquivo.json]    Micro-benchmarks do motor, da tela e dos resultados (padrão: bench.json)
+      --compactar-resultados [arquivo]  Remove linhas inválidas do histórico e refaz o resumo
+      --historico [filtros]     Lista partidas do histórico (--dificuldade N, --palavra P,
+                                --de/--ate AAAA-MM-DD, --vitorias, --derrotas,
+                                --pagina N, --por-pagina K, --arquivo caminho)
     
     Retorna 0 em caso de saída normal
 */
-int main(void) {
-    setup_console();  // Configura console para captura de teclas e cores
+int main(int argc, char* argv[]) {
+    // Opções globais (podem preceder qualquer modo)
+    int carga_paralela = 0;
+    int listas_trocadas = 0;
+    while (argc > 1) {
+        if (strcmp(argv[1], "--carregar-paralelo") == 0) {
+            carga_paralela = 1;
+            argv++;
+            argc--;
+        } else if (strcmp(argv[1], "--semente") == 0 && argc > 2) {
+            semente_fixa = 1;
+            semente_base = strtoull(argv[2], NULL, 0);
+            argv += 2;
+            argc -= 2;
+        } else if (strcmp(argv[1], "--fsync") == 0) {
+            resultados_sincronizar = 1;
+            argv++;
+            argc--;
+        } else if (strcmp(argv[1], "--stats") == 0) {
+            metricas_ativar();
+            atexit(despejar_metricas);  // Qualquer modo, inclusive saídas por erro
+            argv++;
+            argc--;
+        } else if (strcmp(argv[1], "--gravar") == 0 && argc > 2) {
+            arquivo_gravacao = argv[2];
+            argv += 2;
+            argc -= 2;
+        } else if (strcmp(argv[1], "--lista") == 0 && argc > 2) {
+            if (!registrar_lista(argv[2])) return 1;
+            listas_trocadas = 1;
+            argv += 2;
+            argc -= 2;
+        } else {
+            break;
+        }
+    }
+
+    // Compactação e consulta do histórico: não precisam das listas de palavras
+    if (argc > 1 && strcmp(argv[1], "--compactar-resultados") == 0) {
+        return run_compactar_resultados(argc > 2 ? argv[2] : RESULTADOS_ARQUIVO);
+    }
+    if (argc > 1 && strcmp(argv[1], "--historico") == 0) {
+        return run_historico(argc - 2, argv + 2);
+    }
 
-    // Carrega listas de palavras dos arquivos de texto
-WORD_COUNT = carregar_palavras(word_list, "palavras.txt", 0);
-HARD_WORD_COUNT = carregar_palavras(hard_word_list, "palavras_dificeis.txt", 1);
+    // Dicionário compilado (listas + índice prontos); ao compilar, sempre parte dos .txt.
+    // Com --lista o artefato não corresponde às listas pedidas
+    motor_iniciar(&motor);
+    int compilar = argc > 1 && strcmp(argv[1], "--compilar-dicionario") == 0;
+    int do_artefato = !compilar && !listas_trocadas && abrir_dicionario_compilado() == DICIONARIO_OK;
+
+    // Sem artefato válido: carrega listas de palavras dos arquivos de texto
+    if (!do_artefato) {
+        carregar_listas(carga_paralela);
+        if (!carregar_listas_extras()) exit(1);
+        printf("Memória das listas: %.1f KB\n", motor.arena.reservado / 1024.0);
+    }
     
     // Verifica se carregou quantidade mínima de palavras necessárias
-    if (WORD_COUNT < 100 || HARD_WORD_COUNT < 10) {
+    if (motor.normal->n < 100 || motor.dificil->n < 10) {
         printf("Erro: Bancos de palavras não carregados adequadamente\n");
         exit(1);  // Encerra programa se não conseguiu carregar palavras
     }
 
+    // Constrói o índice hash usado por check_word_exists (o artefato já traz o índice)
+    if (!do_artefato && !construir_indice_dicionario(&motor)) {
+        printf("Erro: memória insuficiente para o índice do dicionário\n");
+        exit(1);
+    }
+
+    // Modos de 4, 6, 7 e 8 letras (cada um com sua lista e seu índice)
+    carregar_comprimentos();
+
+    // Modos não interativos (não alteram o terminal)
+    if (compilar) {
+        return run_compilar_dicionario(argc > 2 ? argv[2] : DICIONARIO_ARQUIVO);
+    }
+    if (argc > 1 && strcmp(argv[1], "--gerar-tabela") == 0) {
+        return run_gerar_tabela(argc > 2 ? argv[2] : TABELA_ARQUIVO);
+    }
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        return run_bench(argc > 2 ? argv[2] : "bench.json");
+    }
+    if (argc > 1 && strcmp(argv[1], "--reproduzir") == 0 && argc > 2) {
+        int vezes = argc > 3 ? atoi(argv[3]) : 1;
+        return run_reproduzir(argv[2], vezes > 0 ? vezes : 1);
+    }
+    if (argc > 1 && strcmp(argv[1], "--resolver") == 0) {
+        int nivel = argc > 2 ? atoi(argv[2]) : MEDIUM;
+        if (nivel < EASY || nivel > DEMO) {
+            printf("Dificuldade inválida: use 1 (Fácil), 2 (Médio), 3 (Difícil) ou 4 (Demo)\n");
+            return 1;
+        }
+        return run_resolver((Difficulty)nivel);
+    }
+    if (argc > 1 && strcmp(argv[1], "--lote") == 0) {
+        int threads = argc > 2 ? atoi(argv[2]) : 0;
+        if (threads < 1) threads = tabela_threads_padrao();
+        return run_lote(threads, argc > 3 ? argv[3] : "relatorio_resolver.csv");
+    }
+    if (argc > 1 && strcmp(argv[1], "--servidor") == 0) {
+        // As partidas encerradas vão para o histórico em lotes (um write por lote)
+        if (!resultados_abrir(&resultados, RESULTADOS_ARQUIVO, RESULTADOS_LOTE_PADRAO,
+                              RESULTADOS_INTERVALO_PADRAO, resultados_sincronizar)) {
+            printf("Erro: não foi possível abrir %s\n", RESULTADOS_ARQUIVO);
+            return 1;
+        }
+        if (!abrir_gravacao()) return 1;
+        int codigo = servidor_executar(&motor, argc > 2 ? argv[2] : SERVIDOR_ENDERECO_PADRAO, &resultados,
+                                       SALVAMENTO_SESSOES, gravacao.f ? &gravacao : NULL,
+                                       semente_fixa ? &semente_base : NULL);
+        resultados_fechar(&resultados);
+        fechar_gravacao();
+        printf("Resultados: %llu partida(s) gravada(s) em %llu lote(s), %llu erro(s)\n",
+               (unsigned long long)resultados.stats.registros, (unsigned long long)resultados.stats.lotes,
+               (unsigned long long)resultados.stats.erros);
+        return codigo;
+    }
+    if (argc > 1 && strcmp(argv[1], "--carga") == 0) {
+        return carga_executar(&motor, argc > 2 ? argv[2] : SERVIDOR_ENDERECO_PADRAO,
+                              argc > 3 ? atoi(argv[3]) : 64, argc > 4 ? atoi(argv[4]) : 100);
+    }
+
+    if (!abrir_gravacao()) return 1;
+    if (!tela_iniciar(&tela)) {
+        printf("Erro: memória insuficiente para a tela\n");
+        return 1;
+    }
+    setup_console();  // Configura console para captura de teclas e cores
+
     // Declaração de variáveis para controle do jogo
     int choice;              // Escolha do usuário no menu principal
     int difficulty_choice;   // Escolha de dificuldade selecionada
+    int retomada;            // 1 = partida salva retomada (sem escolher dificuldade)
     GameState game;         // Estado atual do jogo
     char* guess;            // Palpite atual do jogador
     
@@ -1197,38 +1899,54 @@ HARD_WORD_COUNT = carregar_palavras(hard_word_list, "palavras_dificeis.txt", 1);
         
         switch (choice) {
             case 1: // Opção: Jogar
-                difficulty_choice = get_difficulty_choice(); // Seleciona dificuldade
+                retomada = retomar_partida_salva(&game); // Oferece a partida salva, se houver
+                difficulty_choice = retomada ? (int)game.difficulty : get_difficulty_choice(); // Seleciona dificuldade
                 if (difficulty_choice >= 1 && difficulty_choice <= 4) {
-                    init_game(&game, (Difficulty)difficulty_choice); // Inicializa nova partida
+                    if (!retomada) {
+                        int letras = get_length_choice(); // Número de letras (se houver outros comprimentos)
+                        uint64_t semente = proxima_semente();
+                        init_game_letras(&game, &motor, (Difficulty)difficulty_choice, letras, semente); // Inicializa nova partida
+                        gravacao_nova(&gravacao, 0, semente, &game);
+                        salvar_partida(&game); // Salva já no início: uma queda não troca a palavra
+                    } else {
+                        gravacao_retomada(&gravacao, 0, &game);
+                    }
                     
                    // Loop principal da partida - executa até jogo terminar
                    while (!game.game_over) {
-                        display_game_board(&game);  // Mostra tabuleiro atual
-                        display_keyboard(&game);    // Mostra teclado virtual
-                        
-                        guess = get_guess_with_pause(&game); // Obtém palpite do jogador
+                        guess = get_guess_with_pause(&game); // Desenha a tela e obtém palpite do jogador
                         
                         // Se o jogador desistiu no menu de pausa, sair do loop
                         if (guess == NULL) {
                             break;  // Encerra partida atual
                         }
+                        inicio_tentativa = metricas_inicio();  // Termina no próximo quadro (desenhar_jogo)
                         
                         // Verifica se palavra digitada existe no dicionário
-                        if (!check_word_exists(&game, guess)) {
-                            printf("Palavra não encontrada no dicionário. Tente novamente.\n");
-                            printf("Pressione qualquer tecla para continuar...");
+                        uint64_t inicio_validacao = metricas_inicio();
+                        int existe = check_word_exists(&game, guess);
+                        metricas_registrar(METRICA_VALIDACAO, inicio_validacao);
+                        if (!existe) {
+                            gravacao_tentativa(&gravacao, 0, &game, guess, 0);
+                            desenhar_jogo(&game, guess, game.letras,
+                                          "Palavra não encontrada no dicionário. Tente novamente.\n"
+                                          "Pressione qualquer tecla para continuar...");
                             get_char();  // Aguarda confirmação do usuário
                             continue;    // Volta ao início do loop sem processar palpite
                         }
                         
                         process_guess(&game, guess); // Processa palpite válido
+                        gravacao_tentativa(&gravacao, 0, &game, guess, 1);
+                        if (!game.game_over) salvar_partida(&game); // Continua de onde parou após uma queda
                     }
                     
                     // Só mostra tela final se jogador não desistiu
                     if (guess != NULL) {
-                        display_game_board(&game);  // Mostra estado final do tabuleiro
-                        display_keyboard(&game);    // Mostra teclado final
+                        descartar_partida_salva(); // Partida encerrada: nada a retomar
+                        gravacao_fim(&gravacao, 0, &game, FIM_ENCERRADA);
+                        desenhar_jogo(&game, NULL, 0, NULL);  // Estado final do tabuleiro e do teclado
                         display_game_over(&game, game.difficulty);   // Exibe resultado da partida
+                        tela_invalidar(&tela);  // A tela final segue com printf comum
                     }
                 }
                 break;
@@ -1244,6 +1962,14 @@ HARD_WORD_COUNT = carregar_palavras(hard_word_list, "palavras_dificeis.txt", 1);
             case 4: // Opção: Sair
                 clear_screen();
                 printf("Obrigado por jogar! Até logo!\n");
+                if (tela.stats.quadros > 0) {
+                    printf("Renderização: %llu quadro(s), %.0f bytes/quadro em média (máx %zu), %llu redesenho(s) completo(s)\n",
+                           (unsigned long long)tela.stats.quadros,
+                           (double)tela.stats.bytes / (double)tela.stats.quadros,
+                           tela.stats.bytes_maximo, (unsigned long long)tela.stats.completos);
+                }
+                resultados_fechar(&resultados); // Grava o que estiver pendente
+                fechar_gravacao();
                 restore_console(); // Restaura configurações originais do console
                 return 0;          // Encerra programa normalmente
                 
@@ -0,0 +1,161 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "metricas.h"
+
+int metricas_ativas = 0;
+
+// Contadores de uma métrica em uma thread (só a dona escreve)
+typedef struct {
+    uint64_t n;
+    uint64_t soma;
+    uint64_t maximo;
+    uint64_t bytes;
+    uint64_t baldes[METRICAS_BALDES];
+} HistogramaThread;
+
+// Bloco de uma thread; fica na lista depois que a thread termina (as contagens continuam valendo)
+typedef struct BlocoMetricas {
+    HistogramaThread metricas[METRICAS_N];
+    struct BlocoMetricas* proximo;
+} BlocoMetricas;
+
+static BlocoMetricas* blocos = NULL;        // Lista de todos os blocos (inserção no início, com CAS)
+static _Thread_local BlocoMetricas* bloco_thread = NULL;
+
+static const char* NOMES[METRICAS_N] = { "tentativa", "validacao", "tela", "resultados" };
+
+void metricas_ativar(void) {
+    metricas_ativas = 1;
+}
+
+const char* metricas_nome(Metrica m) {
+    return (unsigned)m < METRICAS_N ? NOMES[m] : NULL;
+}
+
+int metricas_buscar(const char* nome) {
+    for (int m = 0; m < METRICAS_N; m++) {
+        if (strcmp(NOMES[m], nome) == 0) return m;
+    }
+    return -1;
+}
+
+// Balde de um valor: exato abaixo de 2^SUB_BITS, depois 2^SUB_BITS baldes por potência de 2
+static inline int balde(uint64_t v) {
+    if (v < (1u << METRICAS_SUB_BITS)) return (int)v;
+    int expoente = 63 - __builtin_clzll(v);
+    int sub = (int)(v >> (expoente - METRICAS_SUB_BITS)) & ((1 << METRICAS_SUB_BITS) - 1);
+    return ((expoente - METRICAS_SUB_BITS + 1) << METRICAS_SUB_BITS) + sub;
+}
+
+// Meio do intervalo de valores de um balde
+static uint64_t valor_balde(int indice) {
+    if (indice < (1 << METRICAS_SUB_BITS)) return (uint64_t)indice;
+    int expoente = (indice >> METRICAS_SUB_BITS) + METRICAS_SUB_BITS - 1;
+    uint64_t sub = (uint64_t)(indice & ((1 << METRICAS_SUB_BITS) - 1));
+    int deslocamento = expoente - METRICAS_SUB_BITS;
+    uint64_t inicio = (((uint64_t)1 << METRICAS_SUB_BITS) + sub) << deslocamento;
+    return inicio + (((uint64_t)1 << deslocamento) >> 1);
+}
+
+static BlocoMetricas* bloco_da_thread(void) {
+    if (bloco_thread) return bloco_thread;
+    BlocoMetricas* b = calloc(1, sizeof(BlocoMetricas));
+    if (!b) return NULL;
+    b->proximo = __atomic_load_n(&blocos, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&blocos, &b->proximo, b, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+        // b->proximo recebeu o início atual da lista: tenta de novo
+    }
+    bloco_thread = b;
+    return b;
+}
+
+// Incremento de um único escritor: leitura e escrita relaxadas (sem lock, visível aos leitores)
+#define SOMAR(campo, valor) \
+    __atomic_store_n(&(campo), __atomic_load_n(&(campo), __ATOMIC_RELAXED) + (valor), __ATOMIC_RELAXED)
+
+void metricas_adicionar(Metrica m, uint64_t ns, uint64_t bytes) {
+    BlocoMetricas* b = bloco_da_thread();
+    if (!b || (unsigned)m >= METRICAS_N) return;
+    HistogramaThread* h = &b->metricas[m];
+    SOMAR(h->n, 1);
+    SOMAR(h->soma, ns);
+    SOMAR(h->bytes, bytes);
+    SOMAR(h->baldes[balde(ns)], 1);
+    if (ns > __atomic_load_n(&h->maximo, __ATOMIC_RELAXED)) __atomic_store_n(&h->maximo, ns, __ATOMIC_RELAXED);
+}
+
+void metricas_resumir(Metrica m, ResumoMetrica* r) {
+    memset(r, 0, sizeof(*r));
+    if ((unsigned)m >= METRICAS_N) return;
+
+    // Soma dos baldes de todas as threads (as contagens de cada balde são lidas uma vez)
+    static _Thread_local uint64_t baldes[METRICAS_BALDES];
+    memset(baldes, 0, sizeof(baldes));
+    uint64_t total = 0;
+    for (BlocoMetricas* b = __atomic_load_n(&blocos, __ATOMIC_ACQUIRE); b; b = b->proximo) {
+        const HistogramaThread* h = &b->metricas[m];
+        r->soma += __atomic_load_n(&h->soma, __ATOMIC_RELAXED);
+        r->bytes += __atomic_load_n(&h->bytes, __ATOMIC_RELAXED);
+        uint64_t maximo = __atomic_load_n(&h->maximo, __ATOMIC_RELAXED);
+        if (maximo > r->maximo) r->maximo = maximo;
+        for (int i = 0; i < METRICAS_BALDES; i++) {
+            uint64_t c = __atomic_load_n(&h->baldes[i], __ATOMIC_RELAXED);
+            baldes[i] += c;
+            total += c;
+        }
+    }
+    // n vem dos baldes: percentis coerentes mesmo com medidas chegando durante a leitura
+    r->n = total;
+    if (total == 0) return;
+
+    uint64_t alvos[3] = { (total * 50 + 99) / 100, (total * 90 + 99) / 100, (total * 99 + 99) / 100 };
+    uint64_t* saidas[3] = { &r->p50, &r->p90, &r->p99 };
+    uint64_t acumulado = 0;
+    int proximo = 0;
+    for (int i = 0; i < METRICAS_BALDES && proximo < 3; i++) {
+        acumulado += baldes[i];
+        while (proximo < 3 && acumulado >= alvos[proximo]) {
+            uint64_t v = valor_balde(i);
+            *saidas[proximo++] = v < r->maximo ? v : r->maximo;
+        }
+    }
+}
+
+// Duração legível: ns, us, ms ou s com 3 algarismos
+static void formatar_duracao(char* destino, size_t tamanho, double ns) {
+    if (ns < 1e3) snprintf(destino, tamanho, "%.0f ns", ns);
+    else if (ns < 1e6) snprintf(destino, tamanho, "%.3g us", ns / 1e3);
+    else if (ns < 1e9) snprintf(destino, tamanho, "%.3g ms", ns / 1e6);
+    else snprintf(destino, tamanho, "%.3g s", ns / 1e9);
+}
+
+size_t metricas_formatar(char* destino, size_t tamanho) {
+    size_t n = 0;
+    if (tamanho == 0) return 0;
+    destino[0] = '\0';
+    for (int m = 0; m < METRICAS_N; m++) {
+        ResumoMetrica r;
+        metricas_resumir((Metrica)m, &r);
+        if (r.n == 0) continue;
+
+        char media[16], p50[16], p99[16], maximo[16];
+        formatar_duracao(media, sizeof(media), (double)r.soma / (double)r.n);
+        formatar_duracao(p50, sizeof(p50), (double)r.p50);
+        formatar_duracao(p99, sizeof(p99), (double)r.p99);
+        formatar_duracao(maximo, sizeof(maximo), (double)r.maximo);
+        int k = snprintf(destino + n, tamanho - n, "%-10s %8llu | média %-9s p50 %-9s p99 %-9s máx %s",
+                         NOMES[m], (unsigned long long)r.n, media, p50, p99, maximo);
+        if (k > 0 && (size_t)k < tamanho - n) n += (size_t)k;
+        if (r.bytes > 0) {
+            k = snprintf(destino + n, tamanho - n, "  | %.0f B/op", (double)r.bytes / (double)r.n);
+            if (k > 0 && (size_t)k < tamanho - n) n += (size_t)k;
+        }
+        if (n + 1 < tamanho) {
+            destino[n++] = '\n';
+            destino[n] = '\0';
+        }
+    }
+    return n;
+}
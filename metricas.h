@@ -0,0 +1,85 @@
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "relogio.h"
+
+/*
+    Instrumentação dos caminhos quentes: onde o tempo vai em produção
+
+    Cada métrica é um histograma de durações (nanossegundos) no estilo HDR:
+    baldes log-lineares, 16 por potência de 2 (erro relativo de até ~3% nos
+    percentis), de 1 ns até o máximo de 64 bits, com contagem, soma e
+    máximo exatos. Algumas métricas também somam bytes (tela, histórico).
+
+    Cada thread escreve só no seu próprio bloco (criado na primeira medida
+    da thread e encadeado sem trava em uma lista global); a leitura soma
+    os blocos de todas as threads com leituras atômicas relaxadas. Nenhuma
+    medida usa trava nem instrução atômica de leitura-modificação-escrita.
+
+    Desligada (o padrão), uma medida custa um teste de variável global:
+    metricas_inicio devolve 0 sem ler o relógio e metricas_registrar não faz
+    nada com início 0. Liga com --stats ou, no jogo, com a tecla de depuração.
+*/
+
+// Métricas medidas
+typedef enum {
+    METRICA_TENTATIVA = 0,  // Tentativa de ponta a ponta (Enter/GUESS até a resposta pronta)
+    METRICA_VALIDACAO,      // check_word_exists
+    METRICA_TELA,           // Composição e envio de um quadro (+ bytes escritos)
+    METRICA_RESULTADOS,     // Gravação de um lote do histórico de resultados (+ bytes)
+    METRICAS_N
+} Metrica;
+
+#define METRICAS_SUB_BITS 4                                 // 2^4 baldes por potência de 2
+#define METRICAS_BALDES ((64 - METRICAS_SUB_BITS + 1) << METRICAS_SUB_BITS)
+
+// Resumo de uma métrica somada entre as threads
+typedef struct {
+    uint64_t n;             // Medidas
+    uint64_t soma;          // Nanossegundos somados
+    uint64_t maximo;
+    uint64_t p50, p90, p99; // Percentis (meio do balde)
+    uint64_t bytes;         // Bytes somados (métricas de escrita)
+} ResumoMetrica;
+
+extern int metricas_ativas;                 // 1 = medindo
+
+// Liga a coleta (as medidas anteriores não existem; nada é zerado)
+void metricas_ativar(void);
+
+// Nome curto de uma métrica ("tentativa", "validacao", ...); NULL se inválida
+const char* metricas_nome(Metrica m);
+
+// Métrica pelo nome; -1 se não existe
+int metricas_buscar(const char* nome);
+
+// Registra uma duração (e bytes) na métrica, no bloco da thread atual
+void metricas_adicionar(Metrica m, uint64_t ns, uint64_t bytes);
+
+// Início de uma medida: 0 se a coleta está desligada (o relógio nem é lido)
+static inline uint64_t metricas_inicio(void) {
+    return metricas_ativas ? agora_nanossegundos() : 0;
+}
+
+// Fim de uma medida começada com metricas_inicio
+static inline void metricas_registrar(Metrica m, uint64_t inicio) {
+    if (inicio) metricas_adicionar(m, agora_nanossegundos() - inicio, 0);
+}
+
+static inline void metricas_registrar_bytes(Metrica m, uint64_t inicio, uint64_t bytes) {
+    if (inicio) metricas_adicionar(m, agora_nanossegundos() - inicio, bytes);
+}
+
+// Soma os blocos de todas as threads (pode ser chamado a qualquer momento, de qualquer thread)
+void metricas_resumir(Metrica m, ResumoMetrica* r);
+
+/*
+    Texto com uma linha por métrica medida (painel do jogo e --stats)
+    @return: Bytes escritos em `destino` (sempre terminado em '\0')
+*/
+size_t metricas_formatar(char* destino, size_t tamanho);
+
+#endif
@@ -0,0 +1,960 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "motor.h"
+#include "feedback.h"
+#include "relogio.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <pthread.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+// Bits acima da chave empacotada (25 bits) guardam as listas da palavra
+#define LISTA_SHIFT 25
+
+/*
+    Dobra de acentos: letra base de cada letra acentuada ('.' = sem letra base)
+    - Latin-1 (U+00C0..U+00FF): índice = code point & 31 (maiúsculas e
+      minúsculas têm o mesmo desenho)
+    - Latin Extended-A (U+0100..U+017F): ũ, ā, ł, ...
+    - Latin Extended Additional (U+1E00..U+1EFF): ẽ, ỹ, ...
+*/
+static const char DOBRA_LATIN1[33] =
+    "AAAAAA.CEEEEIIII.NOOOOO.OUUUUY..";         // À..Þ / à..þ (Æ, Ð, ×, Þ, ß sem base)
+
+static const char DOBRA_LATIN_A[129] =
+    "AAAAAACCCCCCCCDD..EEEEEEEEEEGGGG"
+    "GGGGHH..IIIIIIIIII..JJKK.LLLLLL."
+    "...NNNNNN...OOOOOO..RRRRRRSSSSSS"
+    "SSTTTT..UUUUUUUUUUUUWWYYYZZZZZZS";
+
+static const char DOBRA_LATIN_ADICIONAL[257] =
+    "AABBBBBBCCDDDDDDDDDDEEEEEEEEEEFF"
+    "GGHHHHHHHHHHIIIIKKKKKKLLLLLLLLMM"
+    "MMMMNNNNNNNNOOOOOOOOPPPPRRRRRRRR"
+    "SSSSSSSSSSTTTTTTTTUUUUUUUUUUVVVV"
+    "WWWWWWWWWWXXXXYYZZZZZZHTWYAS...."
+    "AAAAAAAAAAAAAAAAAAAAAAAAEEEEEEEE"
+    "EEEEEEEEIIIIOOOOOOOOOOOOOOOOOOOO"
+    "OOOOUUUUUUUUUUUUUUYYYYYYYY......";
+
+// Letra base (código 0..25) de um code point acentuado, ou -1 se não há
+static int dobrar_acento(uint32_t cp) {
+    char base = '.';
+    if (cp >= 0xC0 && cp < 0x100) base = DOBRA_LATIN1[cp & 31];
+    else if (cp >= 0x100 && cp < 0x180) base = DOBRA_LATIN_A[cp - 0x100];
+    else if (cp >= 0x1E00 && cp < 0x1F00) base = DOBRA_LATIN_ADICIONAL[cp - 0x1E00];
+    return base == '.' ? -1 : base - 'A';
+}
+
+/*
+    Decodifica a sequência UTF-8 que começa em p[*i] (byte >= 0x80)
+    Avança *i até o último byte da sequência
+    @return: Code point, ou 0 se a sequência é inválida (só o primeiro byte é consumido)
+*/
+static uint32_t decodificar_utf8(const unsigned char* p, size_t n, size_t* i) {
+    unsigned c = p[*i];
+    int extras = c >= 0xF8 ? -1 : c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : c >= 0xC0 ? 1 : -1;
+    if (extras < 0 || *i + (size_t)extras >= n) return 0;
+    uint32_t cp = c & (0x3Fu >> extras);
+    for (int k = 1; k <= extras; k++) {
+        unsigned cont = p[*i + (size_t)k];
+        if ((cont & 0xC0) != 0x80) return 0;
+        cp = (cp << 6) | (cont & 0x3F);
+    }
+    *i += (size_t)extras;
+    return cp;
+}
+
+// Conjunto de chaves já vistas (endereçamento aberto, 0 = vazio)
+// Chaves de 64 bits: serve a todos os comprimentos de palavra
+typedef struct {
+    uint64_t* slots;
+    uint32_t mask;
+    int bits;
+} ConjuntoChaves;
+
+static int conjunto_iniciar(ConjuntoChaves* c, size_t capacidade) {
+    c->bits = 4;
+    while (((size_t)1 << c->bits) < capacidade * 2) c->bits++;
+    c->mask = (1u << c->bits) - 1;
+    c->slots = calloc((size_t)1 << c->bits, sizeof(uint64_t));
+    return c->slots != NULL;
+}
+
+// Hash multiplicativo de Fibonacci para chaves de 64 bits
+static uint32_t hash_chave64(uint64_t key, int bits) {
+    return (uint32_t)((key * 0x9E3779B97F4A7C15ull) >> (64 - bits));
+}
+
+// @return: 1 se a chave é nova (e foi inserida), 0 se já estava no conjunto
+static int conjunto_inserir(ConjuntoChaves* c, uint64_t key) {
+    uint32_t pos = hash_chave64(key, c->bits);
+    while (c->slots[pos] != 0) {
+        if (c->slots[pos] == key) return 0;
+        pos = (pos + 1) & c->mask;
+    }
+    c->slots[pos] = key;
+    return 1;
+}
+
+/*
+    Máximo de palavras que cabem em `bytes` de texto: cada palavra ocupa ao
+    menos `letras` letras + '\n' (a última pode não ter o '\n')
+*/
+static size_t capacidade_lista(size_t bytes, int letras) {
+    return bytes / (size_t)(letras + 1) + 1;
+}
+
+/*
+    Normaliza o conteúdo de uma lista (arquivo inteiro em memória) em uma única
+    passada, direto para chaves empacotadas:
+    - letras A-Z maiúsculas ou minúsculas são aceitas como estão
+    - letras acentuadas em UTF-8 (á, ç, õ, ũ, ẽ, ...) viram a letra base
+    - qualquer outro caractere é ignorado
+    - linhas que não têm exatamente `letras` letras são descartadas
+    - palavras repetidas entram uma única vez (conjunto hash)
+    @param destino32: Espaço para capacidade_lista(n, letras) chaves de 32 bits (até 6 letras),
+                      ou NULL para gravar em destino64
+    @param info: Recebe as contagens (pode ser NULL)
+    @return: Número de palavras únicas, ou -1 se faltar memória
+*/
+static int analisar_lista(const unsigned char* p, size_t n, int letras,
+                          uint32_t destino32[], uint64_t destino64[], CargaLista* info) {
+    int count = 0;                              // Palavras únicas
+    int duplicadas = 0, com_acento = 0, descartadas = 0;
+    int j = 0;                                  // Letras encontradas na linha atual
+    int acento = 0;                             // Linha atual teve letra dobrada
+    uint64_t key = 0;                           // Chave empacotada da linha atual
+
+    ConjuntoChaves vistas;
+    if (!conjunto_iniciar(&vistas, capacidade_lista(n, letras))) return -1;
+
+    for (size_t i = 0; i <= n; i++) {
+        unsigned c = i < n ? p[i] : '\n';       // Última linha sem '\n' fecha como as demais
+        if (c == '\n') {
+            if (j == letras) {
+                if (!conjunto_inserir(&vistas, key)) {
+                    duplicadas++;
+                } else {
+                    if (destino32) destino32[count++] = (uint32_t)key;
+                    else destino64[count++] = key;
+                    com_acento += acento;
+                }
+            } else if (j > 0) {
+                descartadas++;
+            }
+            key = 0;
+            j = 0;
+            acento = 0;
+            continue;
+        }
+
+        // Minúscula e maiúscula caem no mesmo intervalo; bytes >= 0x80 ficam
+        // fora de 0..25 pela subtração sem sinal
+        unsigned letra = (c | 0x20u) - 'a';
+        if (letra >= 26) {
+            if (c < 0x80) continue;                 // Pontuação, espaço, '\r', dígitos
+            int base = dobrar_acento(decodificar_utf8(p, n, &i));
+            if (base < 0) continue;                 // Sem letra base (ex.: acento combinante)
+            letra = (unsigned)base;
+            acento = 1;
+        }
+        if (j < letras) key |= (uint64_t)(letra + 1) << (5 * j);  // A=1 ... Z=26
+        j++;
+    }
+
+    free(vistas.slots);
+    if (info) {
+        info->duplicadas = duplicadas;
+        info->com_acento = com_acento;
+        info->descartadas = descartadas;
+    }
+    return count;
+}
+
+// Arquivo de texto inteiro na memória (mmap ou cópia)
+typedef struct {
+    const unsigned char* dados;
+    size_t tamanho;
+    int mapeado;
+} TextoArquivo;
+
+// @return: 1 se o arquivo foi aberto (um arquivo vazio tem dados NULL e tamanho 0)
+static int abrir_texto(const char* nome_arquivo, TextoArquivo* t) {
+    t->dados = NULL;
+    t->tamanho = 0;
+    t->mapeado = 0;
+
+    #ifdef _WIN32
+    FILE* file = fopen(nome_arquivo, "rb");
+    if (!file) return 0;
+    fseek(file, 0, SEEK_END);
+    long tamanho = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (tamanho > 0) {
+        unsigned char* dados = malloc((size_t)tamanho);
+        if (!dados) {
+            fclose(file);
+            return 0;
+        }
+        t->tamanho = fread(dados, 1, (size_t)tamanho, file);
+        t->dados = dados;
+    }
+    fclose(file);
+    return 1;
+    #else
+    int fd = open(nome_arquivo, O_RDONLY);
+    if (fd < 0) return 0;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return 0;
+    }
+    if (st.st_size > 0) {                       // mmap não aceita tamanho 0
+        void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) {
+            close(fd);
+            return 0;
+        }
+        madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+        t->dados = map;
+        t->tamanho = (size_t)st.st_size;
+        t->mapeado = 1;
+    }
+    close(fd);                                  // O mapeamento continua válido sem o fd
+    return 1;
+    #endif
+}
+
+static void fechar_texto(TextoArquivo* t) {
+    #ifndef _WIN32
+    if (t->mapeado) {
+        munmap((void*)t->dados, t->tamanho);
+        return;
+    }
+    #endif
+    free((void*)t->dados);
+}
+
+/**
+ * Função para carregar palavras de um arquivo texto
+ * O arquivo é mapeado na memória (mmap) e normalizado em uma única passada
+ * (acentos, duplicatas), direto para o formato empacotado; no Windows é
+ * lido de uma vez com fread
+ * A lista recebe um vetor da arena dimensionado pelo tamanho do arquivo e
+ * depois ajustado ao número exato de palavras (sem limite fixo)
+ * @param arena: Arena de onde vem a memória da lista
+ * @param lista: Lista a preencher (o conteúdo anterior é substituído)
+ * @param nome_arquivo: Nome do arquivo a ser lido
+ * @param info: Recebe as contagens da normalização (pode ser NULL)
+ * @return: Número de palavras únicas carregadas, ou -1 se o arquivo não abriu ou faltou memória
+ */
+int carregar_palavras(Arena* arena, ListaPalavras* lista, const char* nome_arquivo, CargaLista* info) {
+    TextoArquivo texto;
+    if (!abrir_texto(nome_arquivo, &texto)) return -1;
+
+    size_t capacidade = capacidade_lista(texto.tamanho, WORD_LENGTH);
+    uint32_t* destino = arena_alocar(arena, capacidade * sizeof(uint32_t));
+    int count = destino ? analisar_lista(texto.dados, texto.tamanho, WORD_LENGTH, destino, NULL, info) : -1;
+    fechar_texto(&texto);
+    if (count < 0) return -1;
+
+    // Devolve a sobra para a arena (a estimativa conta linhas, não palavras únicas)
+    uint32_t* ajustado = arena_redimensionar(arena, destino, capacidade * sizeof(uint32_t),
+                                             (size_t)count * sizeof(uint32_t));
+    lista->palavras = ajustado ? ajustado : destino;
+    lista->n = count;
+    lista->capacidade = ajustado ? count : (int)capacidade;
+    return count;
+}
+
+// Uma lista carregada por uma thread
+typedef struct {
+    Arena* arena;
+    ListaPalavras* lista;
+    CargaLista* resultado;
+} CargaTarefa;
+
+#ifdef _WIN32
+static DWORD WINAPI carregar_tarefa(LPVOID arg) {
+#else
+static void* carregar_tarefa(void* arg) {
+#endif
+    CargaTarefa* t = arg;
+    double inicio = agora_segundos();
+    t->resultado->palavras = carregar_palavras(t->arena, t->lista, t->resultado->arquivo, t->resultado);
+    t->resultado->segundos = agora_segundos() - inicio;
+    return 0;
+}
+
+/*
+    Carrega as listas "normal" e "dificil" do motor, medindo o tempo de cada uma
+    @param paralelo: 1 para ler a lista difícil em outra thread ao mesmo tempo
+                     (com uma arena própria, absorvida pela do motor no final)
+    @param resultado: Recebe arquivo, palavras (-1 = não abriu) e segundos de cada lista
+    @return: 1 se os dois arquivos foram abertos, 0 caso contrário
+*/
+int motor_carregar(Motor* motor, const char* arquivo_normal, const char* arquivo_dificil,
+                   int paralelo, CargaLista resultado[2]) {
+    memset(resultado, 0, 2 * sizeof(CargaLista));
+    resultado[0].arquivo = arquivo_normal;
+    resultado[1].arquivo = arquivo_dificil;
+    Arena arena_thread;
+    arena_iniciar(&arena_thread);
+    CargaTarefa tarefas[2] = {
+        { &motor->arena, motor->normal, &resultado[0] },
+        { &motor->arena, motor->dificil, &resultado[1] },
+    };
+
+    int em_thread = 0;
+    if (paralelo) tarefas[1].arena = &arena_thread;
+    #ifdef _WIN32
+    HANDLE thread = NULL;
+    if (paralelo) {
+        thread = CreateThread(NULL, 0, carregar_tarefa, &tarefas[1], 0, NULL);
+        em_thread = thread != NULL;
+    }
+    #else
+    pthread_t thread;
+    if (paralelo) em_thread = pthread_create(&thread, NULL, carregar_tarefa, &tarefas[1]) == 0;
+    #endif
+
+    carregar_tarefa(&tarefas[0]);
+    if (em_thread) {
+        #ifdef _WIN32
+        WaitForSingleObject(thread, INFINITE);
+        CloseHandle(thread);
+        #else
+        pthread_join(thread, NULL);
+        #endif
+    } else {
+        carregar_tarefa(&tarefas[1]);           // Sequencial (ou a thread não pôde ser criada)
+    }
+    arena_absorver(&motor->arena, &arena_thread);
+
+    return resultado[0].palavras >= 0 && resultado[1].palavras >= 0;
+}
+
+/*
+    Carrega um arquivo em uma lista nomeada (criada se ainda não existir)
+    Listas além de "normal" e "dificil" são aceitas como tentativa em qualquer
+    dificuldade; reconstrua o índice depois de carregar
+    @return: Palavras carregadas, ou -1 (arquivo não abriu, memória ou listas demais)
+*/
+int motor_carregar_lista(Motor* motor, const char* nome, const char* arquivo, CargaLista* info) {
+    memset(info, 0, sizeof(*info));
+    info->arquivo = arquivo;
+    ListaPalavras* lista = motor_lista(motor, nome);
+    double inicio = agora_segundos();
+    info->palavras = lista ? carregar_palavras(&motor->arena, lista, arquivo, info) : -1;
+    info->segundos = agora_segundos() - inicio;
+    return info->palavras;
+}
+
+/*
+    Empacota uma palavra de 5 letras maiúsculas em um inteiro de 32 bits
+    Cada letra ocupa 5 bits (A=1 ... Z=26), por isso a chave nunca é 0
+    @return: Chave empacotada ou 0 se a palavra contém algo que não é letra A-Z
+*/
+uint32_t pack_word(const char* word) {
+    uint32_t key = 0;
+    for (int i = 0; i < WORD_LENGTH; i++) {
+        unsigned char c = (unsigned char)toupper((unsigned char)word[i]);
+        if (c < 'A' || c > 'Z') return 0;               // Caractere inválido (ou fim prematuro)
+        key |= (uint32_t)(c - 'A' + 1) << (5 * i);
+    }
+    return key;
+}
+
+/*
+    Desempacota uma chave em texto (5 letras maiúsculas + terminador)
+    @param out: Buffer com pelo menos WORD_LENGTH + 1 posições
+*/
+void unpack_word(uint32_t key, char* out) {
+    for (int i = 0; i < WORD_LENGTH; i++) {
+        out[i] = KEY_CHAR(key, i);
+    }
+    out[WORD_LENGTH] = '\0';
+}
+
+/*
+    Calcula a máscara de presença de letras de uma chave empacotada
+    Bit n ligado = letra de código n (A=1 ... Z=26) aparece na palavra
+*/
+uint32_t word_letter_mask(uint32_t key) {
+    uint32_t mask = 0;
+    for (int i = 0; i < WORD_LENGTH; i++) {
+        mask |= LETTER_BIT(KEY_LETTER(key, i));
+    }
+    return mask;
+}
+
+// Deixa o motor vazio: apenas as listas "normal" e "dificil", sem palavras e sem índice
+void motor_iniciar(Motor* motor) {
+    arena_iniciar(&motor->arena);
+    memset(motor->listas, 0, sizeof(motor->listas));
+    memset(motor->comprimentos, 0, sizeof(motor->comprimentos));
+    motor->n_listas = 0;
+    motor->normal = motor_lista(motor, "normal");
+    motor->dificil = motor_lista(motor, "dificil");
+    memset(&motor->index, 0, sizeof(motor->index));
+    motor->artefato = NULL;
+    motor->artefato_tamanho = 0;
+    motor->artefato_mapeado = 0;
+}
+
+// Índice dentro do dicionário compilado não foi alocado pelo motor
+static int indice_no_artefato(const Motor* motor) {
+    const char* inicio = motor->artefato;
+    const char* slots = (const char*)motor->index.slots;
+    return inicio && slots >= inicio && slots < inicio + motor->artefato_tamanho;
+}
+
+// Libera o índice, o dicionário compilado e, de uma vez, a memória de todas as listas
+void motor_liberar(Motor* motor) {
+    arena_liberar(&motor->arena);
+    if (!indice_no_artefato(motor)) free(motor->index.slots);
+    #ifndef _WIN32
+    if (motor->artefato_mapeado) {
+        munmap(motor->artefato, motor->artefato_tamanho);
+    } else
+    #endif
+    {
+        free(motor->artefato);
+    }
+    motor_iniciar(motor);
+}
+
+/*
+    Procura uma lista pelo nome; se não existir, cria uma lista vazia
+    @return: Lista, ou NULL se o nome é inválido ou não há mais bits no índice
+*/
+ListaPalavras* motor_lista(Motor* motor, const char* nome) {
+    for (int i = 0; i < motor->n_listas; i++) {
+        if (strcmp(motor->listas[i].nome, nome) == 0) return &motor->listas[i];
+    }
+    if (motor->n_listas >= MOTOR_MAX_LISTAS || !*nome || strlen(nome) >= MOTOR_NOME_LISTA) return NULL;
+
+    ListaPalavras* lista = &motor->listas[motor->n_listas];
+    strcpy(lista->nome, nome);
+    lista->bit = 1u << motor->n_listas;
+    motor->n_listas++;
+    return lista;
+}
+
+const ListaPalavras* motor_buscar_lista(const Motor* motor, const char* nome) {
+    for (int i = 0; i < motor->n_listas; i++) {
+        if (strcmp(motor->listas[i].nome, nome) == 0) return &motor->listas[i];
+    }
+    return NULL;
+}
+
+// Garante espaço para `capacidade` palavras (cresce no lugar quando possível)
+int motor_lista_reservar(Motor* motor, ListaPalavras* lista, int capacidade) {
+    if (capacidade <= lista->capacidade) return 1;
+    uint32_t* p = arena_redimensionar(&motor->arena, lista->palavras,
+                                      (size_t)lista->capacidade * sizeof(uint32_t),
+                                      (size_t)capacidade * sizeof(uint32_t));
+    if (!p) return 0;
+    lista->palavras = p;
+    lista->capacidade = capacidade;
+    return 1;
+}
+
+/*
+    Acrescenta uma chave à lista, dobrando a capacidade quando necessário
+    Não verifica duplicatas nem atualiza o índice (reconstrua depois)
+*/
+int motor_lista_adicionar(Motor* motor, ListaPalavras* lista, uint32_t key) {
+    if (lista->n == lista->capacidade &&
+        !motor_lista_reservar(motor, lista, lista->capacidade ? lista->capacidade * 2 : 64)) {
+        return 0;
+    }
+    lista->palavras[lista->n++] = key;
+    return 1;
+}
+
+// Hash multiplicativo de Fibonacci sobre a chave empacotada
+static uint32_t dict_hash(const DictIndex* index, uint32_t key) {
+    return (key * 0x9E3779B1u) >> (32 - index->bits);
+}
+
+// Insere uma chave no índice marcando a lista de origem (acumula se já existir)
+static void dict_insert(DictIndex* index, uint32_t key, uint32_t lista) {
+    uint32_t pos = dict_hash(index, key);
+    while (index->slots[pos] != 0) {
+        if ((index->slots[pos] & ((1u << LISTA_SHIFT) - 1)) == key) {
+            index->slots[pos] |= lista << LISTA_SHIFT;  // Mesma palavra em outra lista
+            return;
+        }
+        pos = (pos + 1) & index->mask;                  // Sondagem linear
+    }
+    index->slots[pos] = key | (lista << LISTA_SHIFT);
+}
+
+/*
+    Constrói o índice do dicionário a partir de todas as listas carregadas
+    Deve ser chamada depois de carregar (ou alterar) as listas
+    A capacidade é a menor potência de 2 com fator de carga <= 50%
+    @return: 1 em caso de sucesso, 0 se faltar memória
+*/
+int construir_indice_dicionario(Motor* motor) {
+    DictIndex* index = &motor->index;
+    int total = 0;
+    for (int l = 0; l < motor->n_listas; l++) total += motor->listas[l].n;
+    int bits = 4;
+    while ((1 << bits) < total * 2) bits++;
+
+    if (!indice_no_artefato(motor)) free(index->slots);
+    index->slots = calloc((size_t)1 << bits, sizeof(uint32_t));
+    if (!index->slots) return 0;
+    index->bits = bits;
+    index->mask = (1u << bits) - 1;
+
+    for (int l = 0; l < motor->n_listas; l++) {
+        const ListaPalavras* lista = &motor->listas[l];
+        for (int i = 0; i < lista->n; i++) {
+            dict_insert(index, lista->palavras[i], lista->bit);
+        }
+    }
+    return 1;
+}
+
+/*
+    Consulta uma palavra no índice do dicionário em O(1) esperado
+    Aceita letras maiúsculas ou minúsculas; só lê o índice (seguro entre threads)
+    @return: Combinação dos bits das listas (LISTA_*), ou 0 se não existe
+*/
+uint32_t buscar_palavra(const Motor* motor, const char* word) {
+    const DictIndex* index = &motor->index;
+    uint32_t key = pack_word(word);
+    if (key == 0 || !index->slots) return 0;
+
+    uint32_t pos = dict_hash(index, key);
+    while (index->slots[pos] != 0) {
+        if ((index->slots[pos] & ((1u << LISTA_SHIFT) - 1)) == key) {
+            return index->slots[pos] >> LISTA_SHIFT;
+        }
+        pos = (pos + 1) & index->mask;
+    }
+    return 0;
+}
+
+/*
+    Monta um vetor com todas as palavras válidas: lista normal seguida da difícil
+    É o eixo usado pela tabela de padrões (tentativas x palavras-alvo)
+    @param total: Recebe o número de palavras do vetor
+    @return: Vetor alocado com malloc (liberar com free) ou NULL sem memória
+*/
+uint32_t* montar_lista_completa(const Motor* motor, uint32_t* total) {
+    const ListaPalavras* normal = motor->normal;
+    const ListaPalavras* dificil = motor->dificil;
+    uint32_t n = (uint32_t)(normal->n + dificil->n);
+    uint32_t* todas = malloc((n + 1) * sizeof(uint32_t));
+    if (!todas) return NULL;
+    if (normal->n) memcpy(todas, normal->palavras, (size_t)normal->n * sizeof(uint32_t));
+    if (dificil->n) memcpy(todas + normal->n, dificil->palavras, (size_t)dificil->n * sizeof(uint32_t));
+    *total = n;
+    return todas;
+}
+
+// Consulta um dicionário de comprimento alternativo: LISTA_NORMAL se a chave existe
+static uint32_t buscar_chave_comprimento(const DicionarioComprimento* d, uint64_t key) {
+    if (!d->slots) return 0;
+    uint32_t pos = hash_chave64(key, d->bits);
+    while (d->slots[pos] != 0) {
+        if (d->slots[pos] == key) return LISTA_NORMAL;
+        pos = (pos + 1) & d->mask;
+    }
+    return 0;
+}
+
+// Motores especializados dos comprimentos alternativos
+#define LETRAS 4
+#include "motor_comprimento.h"
+#define LETRAS 6
+#include "motor_comprimento.h"
+#define LETRAS 7
+#include "motor_comprimento.h"
+#define LETRAS 8
+#include "motor_comprimento.h"
+
+// Comprimento clássico: chaves de 32 bits, kernel de feedback e índice do motor
+static uint64_t empacotar_5(const char* word) {
+    return pack_word(word);
+}
+
+static uint32_t feedback_5(uint64_t guess, uint64_t target) {
+    return feedback_pattern((uint32_t)guess, (uint32_t)target);
+}
+
+static const Comprimento COMPRIMENTO_5 = { WORD_LENGTH, empacotar_5, feedback_5, buscar_palavra };
+
+// @return: Operações do número de letras, ou NULL se não é suportado
+const Comprimento* comprimento_para(int letras) {
+    switch (letras) {
+        case 4: return &COMPRIMENTO_4;
+        case 5: return &COMPRIMENTO_5;
+        case 6: return &COMPRIMENTO_6;
+        case 7: return &COMPRIMENTO_7;
+        case 8: return &COMPRIMENTO_8;
+        default: return NULL;
+    }
+}
+
+// 1 se há palavras para jogar com esse número de letras
+int motor_tem_comprimento(const Motor* motor, int letras) {
+    if (letras == WORD_LENGTH) return motor->normal->n > 0;
+    return comprimento_para(letras) != NULL && motor->comprimentos[letras].n > 0;
+}
+
+/*
+    Carrega a lista de um comprimento alternativo (ex.: palavras_6.txt) e
+    constrói o seu índice; lista e índice ficam na arena do motor
+    @return: Palavras carregadas, ou -1 (comprimento inválido, arquivo não abriu ou memória)
+*/
+int motor_carregar_comprimento(Motor* motor, int letras, const char* arquivo, CargaLista* info) {
+    memset(info, 0, sizeof(*info));
+    info->arquivo = arquivo;
+    info->palavras = -1;
+    if (letras == WORD_LENGTH || !comprimento_para(letras)) return -1;
+
+    double inicio = agora_segundos();
+    TextoArquivo texto;
+    if (!abrir_texto(arquivo, &texto)) return -1;
+    size_t capacidade = capacidade_lista(texto.tamanho, letras);
+    uint64_t* destino = arena_alocar(&motor->arena, capacidade * sizeof(uint64_t));
+    int count = destino ? analisar_lista(texto.dados, texto.tamanho, letras, NULL, destino, info) : -1;
+    fechar_texto(&texto);
+    if (count < 0) return -1;
+
+    DicionarioComprimento* d = &motor->comprimentos[letras];
+    uint64_t* ajustado = arena_redimensionar(&motor->arena, destino, capacidade * sizeof(uint64_t),
+                                             (size_t)count * sizeof(uint64_t));
+    d->palavras = ajustado ? ajustado : destino;
+    d->n = count;
+
+    // Índice com carga de no máximo 50%, como o do comprimento clássico
+    int bits = 4;
+    while ((1 << bits) < count * 2) bits++;
+    d->slots = arena_alocar(&motor->arena, ((size_t)1 << bits) * sizeof(uint64_t));
+    if (!d->slots) {
+        d->n = 0;
+        return -1;
+    }
+    memset(d->slots, 0, ((size_t)1 << bits) * sizeof(uint64_t));
+    d->bits = bits;
+    d->mask = (1u << bits) - 1;
+    for (int i = 0; i < count; i++) {
+        uint32_t pos = hash_chave64(d->palavras[i], bits);
+        while (d->slots[pos] != 0) pos = (pos + 1) & d->mask;   // Chaves já são únicas
+        d->slots[pos] = d->palavras[i];
+    }
+
+    info->palavras = count;
+    info->segundos = agora_segundos() - inicio;
+    return count;
+}
+
+/*
+    Número máximo de tentativas de cada dificuldade
+    Fácil: 7, Médio: 6, Difícil/Demo: 5
+*/
+int max_attempts_for(Difficulty difficulty) {
+    switch (difficulty) {
+        case EASY:
+            return 7;
+        case MEDIUM:
+            return 6;
+        case HARD:
+        case DEMO:
+        default:
+            return 5;
+    }
+}
+
+/*
+    Inicializa um novo jogo com a dificuldade especificada
+    @param game: Ponteiro para a estrutura do estado do jogo
+    @param motor: Dicionário já carregado e indexado (compartilhado, somente leitura)
+    @param difficulty: Nível de dificuldade escolhido pelo jogador
+    @param seed: Semente do gerador aleatório desta sessão
+*/
+void init_game(GameState* game, const Motor* motor, Difficulty difficulty, uint64_t seed) {
+    init_game_letras(game, motor, difficulty, WORD_LENGTH, seed);
+}
+
+/*
+    Inicializa uma partida com `letras` letras por palavra
+    As operações especializadas do comprimento ficam no GameState e são
+    usadas por todas as funções da partida
+    @return: 1 se o comprimento é suportado e tem lista carregada
+*/
+int init_game_letras(GameState* game, const Motor* motor, Difficulty difficulty, int letras, uint64_t seed) {
+    const Comprimento* comprimento = comprimento_para(letras);
+    if (!comprimento || (letras != WORD_LENGTH && motor->comprimentos[letras].n == 0)) return 0;
+
+    game->motor = motor;
+    game->comprimento = comprimento;
+    game->letras = letras;
+    aleatorio_semear(&game->rng, seed);  // Mesma semente = mesma palavra e mesmas dicas
+    game->difficulty = difficulty;
+    game->current_attempt = 0;
+    game->game_over = 0;
+    game->won = 0;
+
+   // Define número máximo de tentativas baseado na dificuldade
+   game->max_attempts = max_attempts_for(difficulty);
+
+   // Inicializa arrays de tentativas e feedback (só as tentativas jogadas são lidas)
+   memset(game->guesses, 0, sizeof(game->guesses));
+   memset(game->padroes, 0, sizeof(game->padroes));
+
+   // Seleciona palavra aleatória baseada na dificuldade (gerador da própria sessão)
+   if (letras != WORD_LENGTH) {
+       // Comprimento alternativo: uma lista só, para todas as dificuldades
+       const DicionarioComprimento* d = &motor->comprimentos[letras];
+       int idx = (int)aleatorio_limite(&game->rng, (uint32_t)d->n);
+       game->target = d->palavras[idx];
+   } else if (difficulty == HARD && motor->dificil->n > 0) {
+       // Modo difícil: usa lista de palavras mais complexas
+       int idx = (int)aleatorio_limite(&game->rng, (uint32_t)motor->dificil->n);
+       game->target = motor->dificil->palavras[idx];
+   } else if (motor->normal->n > 0) {
+       // Modos fácil/médio: usa lista principal de palavras
+       int idx = (int)aleatorio_limite(&game->rng, (uint32_t)motor->normal->n);
+       game->target = motor->normal->palavras[idx];
+   }
+
+   // Modo demonstração: usa palavra fixa para testes (só existe com 5 letras)
+   if (difficulty == DEMO && letras == WORD_LENGTH) {
+       game->target = pack_word("TESTE");      // Palavra conhecida para debugging/demonstração
+   }
+
+   // Letras presentes (atalho do feedback)
+   game->target_mask = 0;
+   for (int i = 0; i < letras; i++) {
+       game->target_mask |= LETTER_BIT(KEY_LETTER(game->target, i));
+   }
+
+   // Inicializa sistema de dicas
+   game->hints_used = 0;                       // Nenhuma dica usada ainda
+   game->last_hint_time = 0;                   // Timestamp da última dica (0 = nunca)
+   game->reveladas = 0;                        // Nenhuma letra revelada ainda
+
+   // Teclado: nenhuma letra usada ainda
+   game->letras_verdes = 0;
+   game->letras_amarelas = 0;
+   game->letras_cinzas = 0;
+   return 1;
+}
+
+/*
+   Verifica se uma palavra existe nas listas de palavras válidas
+
+   Consulta o índice hash do dicionário do motor da sessão (o do número
+   de letras da partida)
+
+   Retorna 1 se palavra existe, 0 caso contrário
+*/
+int check_word_exists(const GameState* game, const char* word) {
+   // Consulta única no índice: devolve em quais listas a palavra aparece
+   uint32_t listas = game->comprimento->buscar(game->motor, word);
+
+   // Lista normal e listas extras valem para qualquer dificuldade
+   if (listas & (LISTA_NORMAL | LISTA_EXTRAS)) return 1;
+
+   // Lista difícil só é aceita no modo difícil
+   if (game->difficulty == HARD && (listas & LISTA_DIFICIL)) return 1;
+
+   return 0;  // Palavra não encontrada em nenhuma lista
+}
+
+/*
+    Incorpora o feedback de uma tentativa (padrão base 3) ao status das
+    letras do teclado. Cada letra fica com o melhor status já visto
+    (verde > amarela > cinza), como no desenho antigo que percorria todas
+    as tentativas
+*/
+static void atualizar_teclado(GameState* game, uint64_t key, uint32_t padrao) {
+    static const uint8_t status_feedback[3] = { TECLA_CINZA, TECLA_AMARELA, TECLA_VERDE };
+    for (int i = 0; i < game->letras; i++, padrao /= 3) {
+        uint32_t codigo = (uint32_t)KEY_LETTER(key, i);            // 1..26
+        uint32_t bit = LETTER_BIT(codigo);
+        uint8_t novo = status_feedback[padrao % 3];
+        if (game->letras_verdes & bit) continue;                    // Verde já é o melhor status
+        if (novo == TECLA_CINZA && (game->letras_amarelas & bit)) continue;
+
+        game->letras_cinzas &= ~bit;                                // Sai do status anterior
+        game->letras_amarelas &= ~bit;
+        if (novo == TECLA_VERDE) game->letras_verdes |= bit;
+        else if (novo == TECLA_AMARELA) game->letras_amarelas |= bit;
+        else game->letras_cinzas |= bit;
+    }
+}
+
+/*
+    Processa uma tentativa válida do jogador no jogo
+    Registra a palavra, calcula feedback, verifica vitória e atualiza estado
+    Determina se o jogo continua, foi vencido ou perdido
+*/
+void process_guess(GameState* game, const char* guess) {
+    uint64_t key = game->comprimento->empacotar(guess);  // Converte a tentativa uma única vez
+
+    // Registra a tentativa atual no histórico do jogo
+    game->guesses[game->current_attempt] = key;
+
+    // Calcula o feedback colorido para a tentativa
+    calculate_feedback(game, key);
+
+    // Atualiza o status das letras uma vez, em vez de a cada desenho do teclado
+    atualizar_teclado(game, key, game->padroes[game->current_attempt]);
+
+    // Vitória: tentativa idêntica à palavra-alvo (uma comparação inteira)
+    if (key == game->target) {
+        game->won = 1;        // Marca como vencido
+        game->game_over = 1;  // Finaliza o jogo
+    }
+
+    // Avança para a próxima tentativa
+    game->current_attempt++;
+
+    // Verifica se esgotou todas as tentativas (derrota)
+    if (game->current_attempt >= game->max_attempts) {
+        game->game_over = 1;  // Finaliza o jogo por falta de tentativas
+        // Nota: game->won permanece 0 (não venceu)
+    }
+
+    // Estados possíveis após esta função:
+    // 1. Jogo continua: game_over=0, won=0
+    // 2. Vitória: game_over=1, won=1
+    // 3. Derrota: game_over=1, won=0
+}
+
+/*
+    Calcula o feedback colorido para uma tentativa do jogador
+    Usa o kernel especializado do número de letras da partida (com 5 letras,
+    o mesmo das análises em lote, feedback.c) e grava o padrão base 3 da
+    tentativa atual (lido por posição com feedback_letra)
+    Retorna: 2=posição correta, 1=letra existe mas posição errada, 0=não existe
+*/
+void calculate_feedback(GameState* game, uint64_t guess) {
+    game->padroes[game->current_attempt] = (uint16_t)game->comprimento->feedback(guess, game->target);
+
+    // Resultado de cada posição no padrão padroes[attempt]:
+    // 2 = Verde: letra correta na posição correta
+    // 1 = Amarelo: letra existe na palavra mas posição errada
+    // 0 = Cinza: letra não existe na palavra-alvo
+}
+
+/*
+   Verifica se uma posição específica da palavra já foi descoberta
+
+   Analisa tentativas anteriores para ver se a posição tem feedback verde
+
+   Retorna 1 se posição foi resolvida, 0 caso contrário
+*/
+int is_position_solved(const GameState* game, int position) {
+   // Percorre todas as tentativas já realizadas pelo jogador
+   for (int attempt = 0; attempt < game->current_attempt; attempt++) {
+       if (feedback_letra(game, attempt, position) == 2) { // Verde = letra correta na posição correta
+           return 1;  // Posição já foi descoberta em tentativa anterior
+       }
+   }
+   return 0;  // Posição ainda não foi descoberta
+}
+
+// Status de uma letra (A-Z, maiúscula ou minúscula) no teclado; consulta direta às máscaras
+StatusTecla status_letra(const GameState* game, char letra) {
+   unsigned codigo = ((unsigned char)letra | 0x20u) - 'a';
+   if (codigo >= 26) return TECLA_NAO_USADA;
+   uint32_t bit = LETTER_BIT(codigo + 1);
+   if (game->letras_verdes & bit) return TECLA_VERDE;
+   if (game->letras_amarelas & bit) return TECLA_AMARELA;
+   if (game->letras_cinzas & bit) return TECLA_CINZA;
+   return TECLA_NAO_USADA;
+}
+
+// 3^i, para ler uma posição do padrão base 3 sem decodificar o resto
+static const uint16_t POTENCIAS_3[PALAVRA_MAX] = { 1, 3, 9, 27, 81, 243, 729, 2187 };
+
+// Feedback de uma posição: 2=correta, 1=posição errada, 0=incorreta, -1=tentativa ainda não jogada
+int feedback_letra(const GameState* game, int tentativa, int posicao) {
+   if (tentativa < 0 || tentativa >= game->current_attempt) return -1;
+   return game->padroes[tentativa] / POTENCIAS_3[posicao] % 3;
+}
+
+// Vetor por posição (0, 1 ou 2) de uma tentativa já jogada
+void feedback_tentativa(const GameState* game, int tentativa, int saida[]) {
+   uint32_t padrao = game->padroes[tentativa];
+   for (int i = 0; i < game->letras; i++, padrao /= 3) saida[i] = (int)(padrao % 3);
+}
+
+// Letra da palavra secreta em uma posição
+char letra_secreta(const GameState* game, int posicao) {
+   return KEY_CHAR(game->target, posicao);
+}
+
+// Palavra secreta em texto (para exibição e para o histórico)
+void palavra_secreta(const GameState* game, char saida[PALAVRA_MAX + 1]) {
+   for (int i = 0; i < game->letras; i++) saida[i] = KEY_CHAR(game->target, i);
+   saida[game->letras] = '\0';
+}
+
+/*
+   Verifica se o jogador pode usar uma dica no momento atual
+
+   Checa limite máximo de dicas e tempo de espera entre dicas
+
+   Retorna 1 se pode usar dica, 0 caso contrário
+*/
+int can_use_hint(const GameState* game, time_t now) {
+   if (game->hints_used >= MAX_HINTS) return 0;  // Já usou todas as dicas disponíveis
+   if (game->hints_used == 0) return 1;          // Primeira dica sempre disponível
+
+   return (now - game->last_hint_time) >= HINT_DELAY;  // Verifica se passou tempo mínimo
+}
+
+/*
+    Revela uma letra da palavra-alvo como dica para o jogador
+    Escolhe aleatoriamente uma posição ainda não revelada ou acertada
+    Atualiza estatísticas de uso de dicas e marca o tempo da última dica
+    @return: Posição revelada (0-based) ou -1 se não há posição disponível
+*/
+int use_hint(GameState* game, time_t now) {
+    // Encontrar posições disponíveis (não reveladas E não acertadas)
+    int available_positions[PALAVRA_MAX];  // Array para armazenar posições válidas
+    int count = 0;                         // Contador de posições disponíveis
+
+    // Percorre todas as posições da palavra
+    for (int i = 0; i < game->letras; i++) {
+        // Verifica se a posição está disponível para dica
+        if (!(game->reveladas & (1u << i)) && !is_position_solved(game, i)) {
+            available_positions[count++] = i;  // Adiciona à lista de disponíveis
+        }
+    }
+
+    // Verifica se ainda há posições disponíveis para dicas
+    if (count == 0) return -1;
+
+    // Escolher uma posição aleatória entre as disponíveis
+    int pos = available_positions[aleatorio_limite(&game->rng, (uint32_t)count)];
+
+    // Revela a letra na posição escolhida
+    game->reveladas |= (uint8_t)(1u << pos);
+
+    // Atualiza estatísticas de dicas
+    game->hints_used++;                    // Incrementa contador de dicas usadas
+    game->last_hint_time = now;            // Registra o tempo da última dica
+
+    return pos;
+}
@@ -0,0 +1,211 @@
+#ifndef MOTOR_H
+#define MOTOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "palavra.h"
+#include "arena.h"
+#include "aleatorio.h"
+
+/*
+    Motor do jogo sem interface
+
+    Toda a lógica de uma partida (sorteio da palavra, validação, feedback,
+    dicas) sem nenhuma E/S de terminal e sem estado global escondido:
+    - Motor: listas nomeadas de palavras e índice, carregados uma vez e
+      somente leitura depois (toda a memória das listas vem de uma arena)
+    - GameState: uma sessão de jogo, com seu próprio gerador aleatório
+
+    Um mesmo Motor pode ser compartilhado por qualquer número de threads e
+    sessões; cada GameState só deve ser usado por uma thread de cada vez.
+    Nenhuma função do caminho de uma tentativa usa travas.
+*/
+
+// Constantes do sistema de dicas
+#define MAX_HINTS 4         // Máximo de dicas permitidas por jogo
+#define HINT_DELAY 30       // Tempo em segundos entre dicas
+
+// Constantes do jogo
+#define MAX_ATTEMPTS 7      // Número máximo de tentativas por jogo
+
+// Listas de palavras do motor
+#define MOTOR_MAX_LISTAS 7  // Uma por bit livre acima da chave no índice (25 + 7 = 32)
+#define MOTOR_NOME_LISTA 16 // Tamanho máximo do nome de uma lista (com terminador)
+
+// Listas às quais uma palavra pertence (bits combináveis no índice do dicionário)
+// A lista na posição i do motor usa o bit 1 << i
+#define LISTA_NORMAL  1u    // "normal": palavras.txt (alvos de Fácil e Médio)
+#define LISTA_DIFICIL 2u    // "dificil": palavras_dificeis.txt (alvos do Difícil)
+#define LISTA_EXTRAS  (((1u << MOTOR_MAX_LISTAS) - 1) & ~(LISTA_NORMAL | LISTA_DIFICIL)) // Listas extras ("custom", ...)
+
+// Enumeração dos níveis de dificuldade
+typedef enum {
+    EASY = 1,    // Fácil - palavras mais comuns
+    MEDIUM = 2,  // Médio - palavras de dificuldade média
+    HARD = 3,    // Difícil - palavras menos comuns
+    DEMO = 4     // Demonstração - para testes
+} Difficulty;
+
+/*
+    Índice do dicionário: tabela hash com endereçamento aberto (sondagem linear)
+    Cada slot guarda a chave empacotada da palavra (5 bits por letra = 25 bits)
+    e, nos bits superiores, as listas onde ela aparece. Slot 0 = vazio.
+*/
+typedef struct {
+    uint32_t* slots;    // Vetor de slots (capacidade potência de 2)
+    uint32_t mask;      // Capacidade - 1, usada para dar a volta na tabela
+    int bits;           // log2 da capacidade, usado na função de hash
+} DictIndex;
+
+// Lista nomeada de palavras (chaves empacotadas), com capacidade crescente
+typedef struct {
+    char nome[MOTOR_NOME_LISTA];                // "normal", "dificil", "custom", ...
+    uint32_t bit;                               // Bit da lista no índice (LISTA_*)
+    uint32_t* palavras;                         // Chaves (memória da arena do motor)
+    int n;                                      // Palavras na lista
+    int capacidade;                             // Espaço reservado em `palavras`
+} ListaPalavras;
+
+/*
+    Dicionário de um comprimento alternativo (PALAVRA_MIN..PALAVRA_MAX, exceto
+    WORD_LENGTH, que usa as listas nomeadas e o índice do motor)
+    Uma única lista por comprimento, usada em todas as dificuldades; as chaves
+    têm 64 bits porque 7 ou 8 letras x 5 bits não cabem em 32
+*/
+typedef struct {
+    uint64_t* palavras;                         // Chaves (memória da arena do motor)
+    int n;                                      // Palavras na lista (0 = comprimento indisponível)
+    uint64_t* slots;                            // Índice: endereçamento aberto, 0 = vazio (arena)
+    uint32_t mask;                              // Capacidade - 1
+    int bits;                                   // log2 da capacidade
+} DicionarioComprimento;
+
+/*
+    Contexto do motor: listas de palavras e índice
+    Não copie um Motor: `normal` e `dificil` apontam para dentro dele
+*/
+typedef struct Motor {
+    Arena arena;                                // Memória de todas as listas (liberada de uma vez)
+    ListaPalavras listas[MOTOR_MAX_LISTAS];     // Listas nomeadas; 0 = normal, 1 = dificil
+    int n_listas;
+    ListaPalavras* normal;                      // Atalho: alvos de Fácil/Médio
+    ListaPalavras* dificil;                     // Atalho: alvos do Difícil
+    DictIndex index;                            // Índice construído após carregar as listas
+    void* artefato;                             // Dicionário compilado (index.slots aponta para dentro)
+    size_t artefato_tamanho;                    // Tamanho da região do artefato
+    int artefato_mapeado;                       // 1 = mmap, 0 = malloc
+    DicionarioComprimento comprimentos[PALAVRA_MAX + 1]; // Por número de letras (WORD_LENGTH não usa)
+} Motor;
+
+/*
+    Operações especializadas para um número de letras, escolhidas no início
+    da partida: dentro de cada função o comprimento é constante (gerada a
+    partir de motor_comprimento.h, ou o motor clássico de 5 letras)
+*/
+typedef struct {
+    int letras;                                                         // Letras por palavra
+    uint64_t (*empacotar)(const char* palavra);                         // Chave empacotada; 0 = inválida
+    uint32_t (*feedback)(uint64_t tentativa, uint64_t alvo);            // Padrão base 3 (feedback[i] * 3^i)
+    uint32_t (*buscar)(const Motor* motor, const char* palavra);        // Listas (LISTA_*) da palavra, ou 0
+} Comprimento;
+
+// Resultado do carregamento de uma lista (motor_carregar)
+typedef struct {
+    const char* arquivo;                        // Caminho lido
+    int palavras;                               // Palavras únicas carregadas (-1 = arquivo não abriu)
+    int duplicadas;                             // Linhas repetidas ignoradas
+    int com_acento;                             // Palavras com letras acentuadas dobradas (á -> A)
+    int descartadas;                            // Linhas sem exatamente o número de letras da lista
+    double segundos;                            // Tempo de leitura + normalização
+} CargaLista;
+
+// Status de uma letra no teclado (em ordem de precedência: o maior prevalece)
+typedef enum {
+    TECLA_NAO_USADA = 0,    // Ainda não aparece em nenhuma tentativa
+    TECLA_CINZA = 1,        // Não existe na palavra
+    TECLA_AMARELA = 2,      // Existe, mas ainda não foi achada na posição certa
+    TECLA_VERDE = 3         // Já apareceu na posição correta
+} StatusTecla;
+
+/*
+    Estrutura principal que armazena todo o estado do jogo
+
+    Layout compacto (~140 bytes), pensado para muitas sessões vivas no mesmo
+    processo (servidor): tentativas empacotadas (5 bits por letra), o
+    feedback de cada tentativa como um único padrão base 3 (feedback[i] * 3^i,
+    até 3^8 = 6561 com 8 letras), as letras reveladas como bits de posição
+    e os contadores pequenos em campos de bits. A palavra em texto e o
+    status de cada tecla são derivados da chave e das máscaras quando
+    necessários (palavra_secreta, letra_secreta, status_letra, feedback_letra).
+    Campos de bits não têm endereço: atribua e leia, mas não passe &campo.
+*/
+typedef struct {
+    const Motor* motor;                             // Dicionário usado pela sessão
+    const Comprimento* comprimento;                 // Operações especializadas para o número de letras
+    uint64_t target;                                // Palavra secreta empacotada (usada no feedback)
+    uint64_t guesses[MAX_ATTEMPTS];                 // Tentativas do jogador empacotadas (0 = vazia)
+    Aleatorio rng;                                  // Gerador aleatório da sessão (PCG32)
+    time_t last_hint_time;                          // Timestamp da última dica solicitada
+    uint32_t target_mask;                           // Máscara de letras presentes na palavra secreta
+    uint32_t letras_verdes;                         // Máscaras (LETTER_BIT) das letras em cada status,
+    uint32_t letras_amarelas;                       // disjuntas: uma letra verde não está nas amarelas
+    uint32_t letras_cinzas;                         // (juntas dão o status de cada tecla)
+    uint16_t padroes[MAX_ATTEMPTS];                 // Feedback de cada tentativa em base 3 (0=incorreta, 1=posição errada, 2=correta)
+    uint8_t reveladas;                              // Bit i = posição i revelada por uma dica
+    unsigned letras : 4;                            // Letras por palavra nesta partida (WORD_LENGTH por padrão)
+    unsigned current_attempt : 4;                   // Tentativa atual (0 a MAX_ATTEMPTS)
+    unsigned max_attempts : 4;                      // Número máximo de tentativas para este jogo
+    unsigned difficulty : 3;                        // Nível de dificuldade (Difficulty)
+    unsigned hints_used : 3;                        // Número de dicas já utilizadas (até MAX_HINTS)
+    unsigned game_over : 1;                         // Flag indicando se o jogo terminou (0=não, 1=sim)
+    unsigned won : 1;                               // Flag indicando se o jogador venceu (0=não, 1=sim)
+} GameState;
+
+// Representação empacotada
+uint32_t pack_word(const char* word);
+void unpack_word(uint32_t key, char* out);
+uint32_t word_letter_mask(uint32_t key);
+
+// Dicionário
+void motor_iniciar(Motor* motor);
+void motor_liberar(Motor* motor);
+ListaPalavras* motor_lista(Motor* motor, const char* nome);
+const ListaPalavras* motor_buscar_lista(const Motor* motor, const char* nome);
+int motor_lista_reservar(Motor* motor, ListaPalavras* lista, int capacidade);
+int motor_lista_adicionar(Motor* motor, ListaPalavras* lista, uint32_t key);
+int carregar_palavras(Arena* arena, ListaPalavras* lista, const char* nome_arquivo, CargaLista* info);
+int motor_carregar(Motor* motor, const char* arquivo_normal, const char* arquivo_dificil,
+                   int paralelo, CargaLista resultado[2]);
+int motor_carregar_lista(Motor* motor, const char* nome, const char* arquivo, CargaLista* info);
+int construir_indice_dicionario(Motor* motor);
+uint32_t buscar_palavra(const Motor* motor, const char* word);
+uint32_t* montar_lista_completa(const Motor* motor, uint32_t* total);
+
+// Comprimentos alternativos (cada um com sua lista e seu índice)
+const Comprimento* comprimento_para(int letras);
+int motor_carregar_comprimento(Motor* motor, int letras, const char* arquivo, CargaLista* info);
+int motor_tem_comprimento(const Motor* motor, int letras);
+
+// Partida
+int max_attempts_for(Difficulty difficulty);
+void init_game(GameState* game, const Motor* motor, Difficulty difficulty, uint64_t seed);
+int init_game_letras(GameState* game, const Motor* motor, Difficulty difficulty, int letras, uint64_t seed);
+int check_word_exists(const GameState* game, const char* word);
+void process_guess(GameState* game, const char* guess);
+void calculate_feedback(GameState* game, uint64_t guess);
+int is_position_solved(const GameState* game, int position);
+StatusTecla status_letra(const GameState* game, char letra);
+
+// Leitura do estado compacto
+int feedback_letra(const GameState* game, int tentativa, int posicao);  // 0, 1, 2 ou -1 (tentativa não jogada)
+void feedback_tentativa(const GameState* game, int tentativa, int saida[]); // Vetor por posição de uma tentativa jogada
+char letra_secreta(const GameState* game, int posicao);
+void palavra_secreta(const GameState* game, char saida[PALAVRA_MAX + 1]);
+
+// Dicas (o horário atual é informado por quem chama)
+int can_use_hint(const GameState* game, time_t now);
+int use_hint(GameState* game, time_t now);
+
+#endif
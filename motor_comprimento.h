@@ -0,0 +1,79 @@
+/*
+    Modelo das operações especializadas por comprimento de palavra
+
+    Incluído por motor.c uma vez para cada comprimento alternativo, com
+    LETRAS definido antes da inclusão (ex.: #define LETRAS 6). Cada inclusão
+    gera empacotar_N, feedback_N e buscar_N, em que o número de letras é uma
+    constante: o compilador desenrola os laços e não sobra nenhum teste de
+    comprimento no caminho de uma tentativa. Sem guarda de inclusão de
+    propósito; LETRAS é removido no final.
+*/
+
+#ifndef LETRAS
+    #error "defina LETRAS antes de incluir motor_comprimento.h"
+#endif
+
+#define COMPRIMENTO_JUNTAR2(a, b) a##b
+#define COMPRIMENTO_JUNTAR(a, b) COMPRIMENTO_JUNTAR2(a, b)
+#define COMPRIMENTO_NOME(f) COMPRIMENTO_JUNTAR(f, LETRAS)
+
+// Converte LETRAS letras (A-Z, maiúsculas ou minúsculas) na chave de 64 bits; 0 = inválida
+static uint64_t COMPRIMENTO_NOME(empacotar_)(const char* word) {
+    uint64_t key = 0;
+    for (int i = 0; i < LETRAS; i++) {
+        unsigned letra = ((unsigned char)word[i] | 0x20u) - 'a';
+        if (letra >= 26) return 0;                      // Caractere inválido (ou fim prematuro)
+        key |= (uint64_t)(letra + 1) << (5 * i);
+    }
+    return key;
+}
+
+/*
+    Mesmo algoritmo de duas passadas e sem desvios de feedback_pattern
+    (feedback.c), com LETRAS posições; devolve o padrão base 3
+*/
+static uint32_t COMPRIMENTO_NOME(feedback_)(uint64_t guess, uint64_t target) {
+    uint32_t g[LETRAS], t[LETRAS], green[LETRAS], used[LETRAS];
+
+    // PRIMEIRA PASSADA: verdes (máscara 0xFFFFFFFF quando a letra coincide)
+    for (int i = 0; i < LETRAS; i++) {
+        g[i] = (uint32_t)KEY_LETTER(guess, i);
+        t[i] = (uint32_t)KEY_LETTER(target, i);
+        green[i] = 0u - (uint32_t)(g[i] == t[i]);
+        used[i] = green[i];                             // Posição verde já está consumida
+    }
+
+    // SEGUNDA PASSADA: amarelos, consumindo a primeira posição livre da palavra-alvo
+    uint32_t pattern = 0, pow3 = 1;
+    for (int i = 0; i < LETRAS; i++) {
+        uint32_t found = green[i];                      // Verdes não procuram amarelo
+        for (int j = 0; j < LETRAS; j++) {
+            uint32_t m = (0u - (uint32_t)(t[j] == g[i])) & ~used[j] & ~found;
+            found |= m;
+            used[j] |= m;
+        }
+        uint32_t fb = (green[i] & 2u) | (found & ~green[i] & 1u);
+        pattern += fb * pow3;
+        pow3 *= 3;
+    }
+    return pattern;
+}
+
+// Consulta o dicionário de LETRAS letras do motor
+static uint32_t COMPRIMENTO_NOME(buscar_)(const Motor* motor, const char* word) {
+    uint64_t key = COMPRIMENTO_NOME(empacotar_)(word);
+    if (key == 0 || word[LETRAS] != '\0') return 0;
+    return buscar_chave_comprimento(&motor->comprimentos[LETRAS], key);
+}
+
+static const Comprimento COMPRIMENTO_NOME(COMPRIMENTO_) = {
+    LETRAS,
+    COMPRIMENTO_NOME(empacotar_),
+    COMPRIMENTO_NOME(feedback_),
+    COMPRIMENTO_NOME(buscar_),
+};
+
+#undef COMPRIMENTO_NOME
+#undef COMPRIMENTO_JUNTAR
+#undef COMPRIMENTO_JUNTAR2
+#undef LETRAS
@@ -0,0 +1,19 @@
+#ifndef PALAVRA_H
+#define PALAVRA_H
+
+#include <stdint.h>
+
+// Comprimento padrão das palavras (Wordle clássico)
+#define WORD_LENGTH 5
+
+// Comprimentos aceitos nos modos alternativos (4, 6, 7 e 8 letras)
+#define PALAVRA_MIN 4
+#define PALAVRA_MAX 8
+
+// Representação compacta das palavras: 5 letras x 5 bits em um uint32_t (A=1 ... Z=26)
+// Os comprimentos alternativos usam o mesmo formato em um uint64_t (até 8 x 5 = 40 bits)
+#define KEY_LETTER(key, i) (((key) >> (5 * (i))) & 31u)        // Código (1-26) da letra na posição i
+#define KEY_CHAR(key, i)   ((char)('A' - 1 + KEY_LETTER(key, i))) // Letra na posição i como caractere
+#define LETTER_BIT(code)   (1u << (code))                       // Bit da letra na máscara de presença
+
+#endif
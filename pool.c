@@ -0,0 +1,67 @@
+#include <stdlib.h>
+
+#include "pool.h"
+
+#define POOL_ALINHAMENTO 16
+
+struct PoolLaje {
+    PoolLaje* anterior;     // Laje aberta antes desta
+};
+
+// Os objetos começam logo após o cabeçalho, já alinhados
+#define POOL_CABECALHO ((sizeof(PoolLaje) + POOL_ALINHAMENTO - 1) & ~(size_t)(POOL_ALINHAMENTO - 1))
+
+void pool_iniciar(Pool* pool, size_t tamanho, size_t por_laje) {
+    if (tamanho < sizeof(void*)) tamanho = sizeof(void*);   // Cabe o elo da lista de livres
+    pool->tamanho = (tamanho + POOL_ALINHAMENTO - 1) & ~(size_t)(POOL_ALINHAMENTO - 1);
+    pool->por_laje = por_laje ? por_laje : POOL_OBJETOS_POR_LAJE;
+    pool->lajes = NULL;
+    pool->livres = NULL;
+    pool->proximo = NULL;
+    pool->fim = NULL;
+    pool->em_uso = 0;
+    pool->pico = 0;
+    pool->reservado = 0;
+}
+
+void* pool_obter(Pool* pool) {
+    void* objeto;
+    if (pool->livres) {
+        // Reutiliza o último devolvido
+        objeto = pool->livres;
+        pool->livres = *(void**)objeto;
+    } else {
+        if (pool->proximo == pool->fim) {
+            // Laje nova: os objetos são entregues em sequência, sem montar a lista de livres
+            size_t bytes = pool->tamanho * pool->por_laje;
+            PoolLaje* laje = malloc(POOL_CABECALHO + bytes);
+            if (!laje) return NULL;
+            laje->anterior = pool->lajes;
+            pool->lajes = laje;
+            pool->proximo = (unsigned char*)laje + POOL_CABECALHO;
+            pool->fim = pool->proximo + bytes;
+            pool->reservado += POOL_CABECALHO + bytes;
+        }
+        objeto = pool->proximo;
+        pool->proximo += pool->tamanho;
+    }
+    if (++pool->em_uso > pool->pico) pool->pico = pool->em_uso;
+    return objeto;
+}
+
+void pool_devolver(Pool* pool, void* objeto) {
+    if (!objeto) return;
+    *(void**)objeto = pool->livres;
+    pool->livres = objeto;
+    pool->em_uso--;
+}
+
+void pool_liberar(Pool* pool) {
+    PoolLaje* laje = pool->lajes;
+    while (laje) {
+        PoolLaje* anterior = laje->anterior;
+        free(laje);
+        laje = anterior;
+    }
+    pool_iniciar(pool, pool->tamanho, pool->por_laje);
+}
@@ -0,0 +1,45 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <stddef.h>
+
+/*
+    Pool de objetos de tamanho fixo (sessões do servidor, partidas)
+
+    Os objetos vêm de blocos grandes (lajes) pedidos ao sistema de uma vez;
+    obter e devolver são O(1): um objeto devolvido entra em uma lista de
+    livres encadeada dentro dele mesmo e é o primeiro a ser reutilizado
+    (ainda quente no cache). Objetos nunca voltam ao sistema um a um: as
+    lajes são liberadas todas juntas em pool_liberar.
+    Não é thread-safe: cada thread usa seu próprio pool.
+*/
+
+#define POOL_OBJETOS_POR_LAJE 1024      // Objetos em cada laje (padrão)
+
+typedef struct PoolLaje PoolLaje;
+
+typedef struct {
+    size_t tamanho;         // Bytes de cada objeto (alinhado a 16)
+    size_t por_laje;        // Objetos em cada laje nova
+    PoolLaje* lajes;        // Lajes encadeadas (a mais recente primeiro)
+    void* livres;           // Objetos devolvidos, prontos para reutilizar
+    unsigned char* proximo; // Próximo objeto nunca usado da laje mais recente
+    unsigned char* fim;     // Fim da laje mais recente
+    size_t em_uso;          // Objetos entregues e ainda não devolvidos
+    size_t pico;            // Maior valor de em_uso
+    size_t reservado;       // Bytes pedidos ao sistema
+} Pool;
+
+// Prepara um pool de objetos de `tamanho` bytes (`por_laje` 0 = POOL_OBJETOS_POR_LAJE)
+void pool_iniciar(Pool* pool, size_t tamanho, size_t por_laje);
+
+// Um objeto com conteúdo indefinido, alinhado a 16; NULL se faltar memória
+void* pool_obter(Pool* pool);
+
+// Devolve um objeto obtido deste pool
+void pool_devolver(Pool* pool, void* objeto);
+
+// Libera todas as lajes de uma vez (objetos ainda em uso deixam de valer)
+void pool_liberar(Pool* pool);
+
+#endif
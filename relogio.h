@@ -0,0 +1,42 @@
+#ifndef RELOGIO_H
+#define RELOGIO_H
+
+#include <stdint.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <time.h>
+#endif
+
+/*
+    Relógio monotônico em segundos, usado para medir tempos de execução
+*/
+static inline double agora_segundos(void) {
+    #ifdef _WIN32
+        LARGE_INTEGER freq, count;
+        QueryPerformanceFrequency(&freq);
+        QueryPerformanceCounter(&count);
+        return (double)count.QuadPart / (double)freq.QuadPart;
+    #else
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+    #endif
+}
+
+// O mesmo relógio em nanossegundos inteiros (medições de operações curtas)
+static inline uint64_t agora_nanossegundos(void) {
+    #ifdef _WIN32
+        LARGE_INTEGER freq, count;
+        QueryPerformanceFrequency(&freq);
+        QueryPerformanceCounter(&count);
+        return (uint64_t)((double)count.QuadPart * 1e9 / (double)freq.QuadPart);
+    #else
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+    #endif
+}
+
+#endif
@@ -0,0 +1,267 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "resolver.h"
+
+int resolver_base_iniciar(ResolverBase* base, const uint32_t* palavras, uint32_t n_palavras,
+                          const PatternTable* tabela) {
+    memset(base, 0, sizeof(*base));
+    base->palavras = palavras;
+    base->n_palavras = n_palavras;
+    base->tabela = (tabela && tabela->n == n_palavras) ? tabela : NULL;
+
+    // c * log2(c) pré-calculado: a entropia vira uma soma de 243 consultas
+    base->xlogx = malloc(((size_t)n_palavras + 1) * sizeof(double));
+    if (!base->xlogx) return 0;
+    base->xlogx[0] = 0.0;
+    for (uint32_t c = 1; c <= n_palavras; c++) {
+        base->xlogx[c] = (double)c * log2((double)c);
+    }
+    return 1;
+}
+
+void resolver_base_liberar(ResolverBase* base) {
+    free(base->xlogx);
+    memset(base, 0, sizeof(*base));
+}
+
+/*
+    Soma de c*log2(c) sobre os baldes de padrão de um palpite
+    Entropia = log2(n) - soma/n, então MENOR soma = MAIOR entropia
+*/
+static double soma_baldes(Resolver* r, uint32_t palpite) {
+    const ResolverBase* base = r->base;
+    uint32_t* cont = r->cont;
+    const uint8_t* padroes = r->padroes;
+    int n_tocados = 0;
+
+    if (base->tabela) {
+        // Uma leitura de byte por candidata na linha do palpite
+        const uint8_t* linha = base->tabela->matrix + (size_t)palpite * base->tabela->n;
+        for (uint32_t k = 0; k < r->n; k++) {
+            r->padroes[k] = linha[r->candidatos[k]];
+        }
+    } else {
+        feedback_score(base->palavras[palpite], r->chaves, r->n, r->padroes);
+    }
+
+    // Só os baldes tocados entram na soma e são zerados de volta: com poucas
+    // candidatas o custo é O(n) em vez de O(243) por palpite
+    for (uint32_t k = 0; k < r->n; k++) {
+        if (cont[padroes[k]]++ == 0) r->tocados[n_tocados++] = padroes[k];
+    }
+
+    double soma = 0.0;
+    for (int i = 0; i < n_tocados; i++) {
+        soma += base->xlogx[cont[r->tocados[i]]];
+        cont[r->tocados[i]] = 0;
+    }
+    return soma;
+}
+
+/*
+    Considera um palpite; empates favorecem quem ainda pode ser a resposta
+    @return: 1 se o palpite é imbatível (candidata que separa todas as outras)
+*/
+static int considerar(Resolver* r, uint32_t g, uint32_t* melhor, double* melhor_soma) {
+    double s = soma_baldes(r, g);
+    if (*melhor == RESOLVER_NENHUM || s < *melhor_soma - 1e-9 ||
+        (s <= *melhor_soma + 1e-9 && r->eh_candidata[g] && !r->eh_candidata[*melhor])) {
+        *melhor = g;
+        *melhor_soma = s;
+    }
+    return *melhor_soma < 1e-9 && r->eh_candidata[*melhor];
+}
+
+/*
+    Procura o palpite de maior entropia
+    @param so_candidatas: 1 para considerar apenas palavras que ainda podem ser a resposta
+*/
+static uint32_t melhor_palpite(Resolver* r, int so_candidatas) {
+    uint32_t melhor = RESOLVER_NENHUM;
+    double melhor_soma = 0.0;
+
+    // Candidatas primeiro: uma separação perfeita entre elas encerra a busca
+    for (uint32_t k = 0; k < r->n; k++) {
+        if (considerar(r, r->candidatos[k], &melhor, &melhor_soma)) return melhor;
+    }
+    if (!so_candidatas) {
+        for (uint32_t g = r->palp_ini; g < r->palp_fim; g++) {
+            if (r->eh_candidata[g]) continue;   // Já avaliada acima
+            if (considerar(r, g, &melhor, &melhor_soma)) break;
+        }
+    }
+    return melhor;
+}
+
+// Procura a abertura memorizada para as faixas (NULL se ainda não calculada)
+static ResolverAbertura* buscar_abertura(const ResolverBase* base, uint32_t cand_ini, uint32_t cand_fim,
+                                         uint32_t palp_ini, uint32_t palp_fim) {
+    for (int i = 0; i < base->n_aberturas; i++) {
+        const ResolverAbertura* a = &base->aberturas[i];
+        if (a->cand_ini == cand_ini && a->cand_fim == cand_fim &&
+            a->palp_ini == palp_ini && a->palp_fim == palp_fim) {
+            return (ResolverAbertura*)a;
+        }
+    }
+    return NULL;
+}
+
+/*
+    Melhor abertura para uma combinação de listas
+    O primeiro turno é igual em todos os jogos, então o resultado é memorizado
+    Não é thread-safe quando precisa calcular: chame antes de iniciar threads
+*/
+uint32_t resolver_abertura(ResolverBase* base, uint32_t cand_ini, uint32_t cand_fim,
+                           uint32_t palp_ini, uint32_t palp_fim) {
+    ResolverAbertura* memo = buscar_abertura(base, cand_ini, cand_fim, palp_ini, palp_fim);
+    if (memo) return memo->palpite;
+
+    Resolver r;
+    if (!resolver_iniciar(&r, base, cand_ini, cand_fim, palp_ini, palp_fim)) {
+        return RESOLVER_NENHUM;
+    }
+    uint32_t palpite = melhor_palpite(&r, 0);
+    resolver_liberar(&r);
+
+    if (base->n_aberturas < RESOLVER_MAX_ABERTURAS) {
+        ResolverAbertura* a = &base->aberturas[base->n_aberturas++];
+        a->cand_ini = cand_ini;
+        a->cand_fim = cand_fim;
+        a->palp_ini = palp_ini;
+        a->palp_fim = palp_fim;
+        a->palpite = palpite;
+        a->tem_segundo = 0;
+    }
+    return palpite;
+}
+
+/*
+    Memoriza também o segundo turno: ele depende apenas do padrão recebido na
+    abertura, então há no máximo 243 respostas diferentes
+    Depois desta chamada a base pode ser usada por várias threads sem escrita
+    @return: 1 em caso de sucesso, 0 se faltar memória
+*/
+int resolver_preparar(ResolverBase* base, uint32_t cand_ini, uint32_t cand_fim,
+                      uint32_t palp_ini, uint32_t palp_fim) {
+    uint32_t abertura = resolver_abertura(base, cand_ini, cand_fim, palp_ini, palp_fim);
+    ResolverAbertura* memo = buscar_abertura(base, cand_ini, cand_fim, palp_ini, palp_fim);
+    if (abertura == RESOLVER_NENHUM || !memo) return 0;
+    if (memo->tem_segundo) return 1;
+
+    Resolver r;
+    if (!resolver_iniciar(&r, base, cand_ini, cand_fim, palp_ini, palp_fim)) return 0;
+    for (int p = 0; p < FEEDBACK_PATTERNS; p++) {
+        resolver_reiniciar(&r);
+        resolver_filtrar(&r, abertura, (uint8_t)p);
+        // Segundo turno sempre tem mais de uma tentativa restante
+        memo->segundo[p] = r.n > 0 ? resolver_escolher(&r, 2) : RESOLVER_NENHUM;
+    }
+    resolver_liberar(&r);
+    memo->tem_segundo = 1;
+    return 1;
+}
+
+int resolver_iniciar(Resolver* r, ResolverBase* base, uint32_t cand_ini, uint32_t cand_fim,
+                     uint32_t palp_ini, uint32_t palp_fim) {
+    memset(r, 0, sizeof(*r));
+    r->base = base;
+    r->cand_ini = cand_ini;
+    r->cand_fim = cand_fim;
+    r->palp_ini = palp_ini;
+    r->palp_fim = palp_fim;
+
+    uint32_t n = cand_fim - cand_ini;
+    r->candidatos = malloc(((size_t)n + 1) * sizeof(uint32_t));
+    r->chaves = malloc(((size_t)n + 1) * sizeof(uint32_t));
+    r->padroes = malloc((size_t)n + 1);
+    r->eh_candidata = calloc((size_t)base->n_palavras + 1, 1);
+    if (!r->candidatos || !r->chaves || !r->padroes || !r->eh_candidata) {
+        resolver_liberar(r);
+        return 0;
+    }
+
+    resolver_reiniciar(r);
+    return 1;
+}
+
+void resolver_reiniciar(Resolver* r) {
+    uint32_t n = r->cand_fim - r->cand_ini;
+    memset(r->eh_candidata, 0, (size_t)r->base->n_palavras);
+    for (uint32_t k = 0; k < n; k++) {
+        r->candidatos[k] = r->cand_ini + k;
+        r->chaves[k] = r->base->palavras[r->cand_ini + k];
+        r->eh_candidata[r->cand_ini + k] = 1;
+    }
+    r->n = n;
+    r->turno = 0;
+    r->padrao_abertura = 0;
+}
+
+/*
+    Escolhe a próxima tentativa
+    - Uma candidata restante: é a resposta
+    - Primeiro turno: abertura memorizada
+    - Segundo turno: resposta memorizada por resolver_preparar, se houver
+    - Última tentativa ou até 2 candidatas: só vale chutar uma possível resposta
+    - Caso geral: palpite de maior entropia entre todos os aceitos
+*/
+uint32_t resolver_escolher(Resolver* r, int tentativas_restantes) {
+    if (r->n == 0) return RESOLVER_NENHUM;         // Feedback inconsistente com as listas
+    if (r->n == 1) return r->candidatos[0];
+
+    if (r->turno == 0 && tentativas_restantes > 1) {
+        uint32_t abertura = resolver_abertura(r->base, r->cand_ini, r->cand_fim, r->palp_ini, r->palp_fim);
+        if (abertura != RESOLVER_NENHUM) return abertura;
+    }
+    if (r->turno == 1 && tentativas_restantes > 1) {
+        const ResolverAbertura* memo = buscar_abertura(r->base, r->cand_ini, r->cand_fim, r->palp_ini, r->palp_fim);
+        if (memo && memo->tem_segundo && memo->segundo[r->padrao_abertura] != RESOLVER_NENHUM) {
+            return memo->segundo[r->padrao_abertura];
+        }
+    }
+
+    return melhor_palpite(r, tentativas_restantes <= 1 || r->n <= 2);
+}
+
+void resolver_filtrar(Resolver* r, uint32_t palpite, uint8_t padrao) {
+    const ResolverBase* base = r->base;
+    uint32_t m = 0;
+
+    if (base->tabela) {
+        const uint8_t* linha = base->tabela->matrix + (size_t)palpite * base->tabela->n;
+        for (uint32_t k = 0; k < r->n; k++) {
+            r->padroes[k] = linha[r->candidatos[k]];
+        }
+    } else {
+        feedback_score(base->palavras[palpite], r->chaves, r->n, r->padroes);
+    }
+
+    // Compacta as candidatas compatíveis no início dos vetores
+    for (uint32_t k = 0; k < r->n; k++) {
+        uint32_t idx = r->candidatos[k];
+        if (r->padroes[k] == padrao) {
+            r->candidatos[m] = idx;
+            r->chaves[m] = r->chaves[k];
+            m++;
+        } else {
+            r->eh_candidata[idx] = 0;
+        }
+    }
+    r->n = m;
+    if (r->turno == 0) r->padrao_abertura = padrao;
+    r->turno++;
+}
+
+void resolver_liberar(Resolver* r) {
+    free(r->candidatos);
+    free(r->chaves);
+    free(r->padroes);
+    free(r->eh_candidata);
+    r->candidatos = NULL;
+    r->chaves = NULL;
+    r->padroes = NULL;
+    r->eh_candidata = NULL;
+    r->n = 0;
+}
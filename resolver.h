@@ -0,0 +1,86 @@
+#ifndef RESOLVER_H
+#define RESOLVER_H
+
+#include <stdint.h>
+#include "tabela.h"
+#include "feedback.h"
+
+/*
+    Resolvedor por máxima entropia
+
+    Mantém o conjunto de palavras-alvo ainda possíveis e escolhe a tentativa
+    que maximiza a informação esperada (entropia da distribuição dos 243
+    padrões de feedback sobre as candidatas restantes). Depois de cada
+    tentativa, só as candidatas compatíveis com o padrão observado sobrevivem.
+
+    As palavras são referenciadas por índice em um vetor único (lista normal
+    seguida da difícil), o mesmo eixo da tabela de padrões.
+*/
+
+#define RESOLVER_MAX_ABERTURAS 4   // Aberturas memorizadas (uma por combinação de listas)
+#define RESOLVER_NENHUM UINT32_MAX  // Índice inválido / abertura ainda não calculada
+
+// Abertura memorizada para uma combinação de faixas de palpites e candidatas
+typedef struct {
+    uint32_t cand_ini, cand_fim;
+    uint32_t palp_ini, palp_fim;
+    uint32_t palpite;
+    uint32_t segundo[FEEDBACK_PATTERNS];    // Segundo palpite por padrão da abertura (resolver_preparar)
+    int tem_segundo;                        // 1 depois de resolver_preparar
+} ResolverAbertura;
+
+// Dados compartilhados (somente leitura durante os jogos, exceto a memória de aberturas)
+typedef struct {
+    const uint32_t* palavras;       // Todas as palavras empacotadas
+    uint32_t n_palavras;            // Tamanho de palavras
+    const PatternTable* tabela;     // Tabela de padrões (NULL = usa o kernel de feedback)
+    double* xlogx;                  // xlogx[c] = c * log2(c), c = 0..n_palavras
+    ResolverAbertura aberturas[RESOLVER_MAX_ABERTURAS];
+    int n_aberturas;
+} ResolverBase;
+
+// Estado de um jogo sendo resolvido
+typedef struct {
+    ResolverBase* base;
+    uint32_t palp_ini, palp_fim;    // Faixa de índices aceitos como tentativa
+    uint32_t cand_ini, cand_fim;    // Faixa inicial de palavras-alvo possíveis
+    uint32_t* candidatos;           // Índices das candidatas restantes
+    uint32_t* chaves;               // Chaves das candidatas (caminho sem tabela)
+    uint8_t* padroes;               // Rascunho com um padrão por candidata
+    uint8_t* eh_candidata;          // eh_candidata[i] = 1 se a palavra i ainda é possível
+    uint32_t n;                     // Quantidade de candidatas restantes
+    int turno;                      // Tentativas já filtradas
+    uint8_t padrao_abertura;        // Padrão recebido no primeiro turno
+    uint32_t cont[FEEDBACK_PATTERNS];   // Rascunho: tamanho de cada balde (sempre zerado entre usos)
+    uint8_t tocados[FEEDBACK_PATTERNS]; // Rascunho: baldes usados pelo palpite avaliado
+} Resolver;
+
+// Prepara os dados compartilhados; `tabela` pode ser NULL
+int resolver_base_iniciar(ResolverBase* base, const uint32_t* palavras, uint32_t n_palavras,
+                          const PatternTable* tabela);
+void resolver_base_liberar(ResolverBase* base);
+
+// Calcula (ou devolve da memória) a melhor abertura para as faixas dadas
+uint32_t resolver_abertura(ResolverBase* base, uint32_t cand_ini, uint32_t cand_fim,
+                           uint32_t palp_ini, uint32_t palp_fim);
+
+// Calcula abertura e todos os segundos palpites de uma vez (antes de usar em várias threads)
+int resolver_preparar(ResolverBase* base, uint32_t cand_ini, uint32_t cand_fim,
+                      uint32_t palp_ini, uint32_t palp_fim);
+
+// Inicia um jogo: candidatas = [cand_ini, cand_fim), palpites = [palp_ini, palp_fim)
+int resolver_iniciar(Resolver* r, ResolverBase* base, uint32_t cand_ini, uint32_t cand_fim,
+                     uint32_t palp_ini, uint32_t palp_fim);
+
+// Volta ao início do jogo reaproveitando a memória já alocada
+void resolver_reiniciar(Resolver* r);
+
+// Escolhe o índice da próxima tentativa considerando as tentativas que restam
+uint32_t resolver_escolher(Resolver* r, int tentativas_restantes);
+
+// Mantém só as candidatas para as quais `palpite` produziria `padrao`
+void resolver_filtrar(Resolver* r, uint32_t palpite, uint8_t padrao);
+
+void resolver_liberar(Resolver* r);
+
+#endif
@@ -0,0 +1,636 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "resultados.h"
+#include "relogio.h"
+#include "metricas.h"
+
+#ifdef _WIN32
+    #include <io.h>
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #define res_open(caminho) _open(caminho, _O_RDWR | _O_APPEND | _O_CREAT | _O_BINARY, _S_IREAD | _S_IWRITE)
+    #define res_write _write
+    #define res_read _read
+    #define res_lseek _lseeki64
+    #define res_fsync _commit
+    #define res_close _close
+    #define res_fseek _fseeki64
+    #define res_ftell _ftelli64
+    #define res_truncate _chsize_s
+#else
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #define res_open(caminho) open(caminho, O_RDWR | O_APPEND | O_CREAT, 0644)
+    #define res_write write
+    #define res_read read
+    #define res_lseek lseek
+    #define res_fsync fsync
+    #define res_close close
+    #define res_fseek fseeko
+    #define res_ftell ftello
+    #define res_truncate ftruncate
+#endif
+
+#define RESULTADOS_BLOCO_LEITURA (64 * 1024)    // Leitura do histórico em blocos deste tamanho
+
+static const char* const NOMES_DIFICULDADE[] = { "", "FÁCIL", "MÉDIO", "DIFÍCIL", "DEMO" };
+
+const char* resultados_nome_dificuldade(int dificuldade) {
+    return dificuldade >= EASY && dificuldade <= DEMO ? NOMES_DIFICULDADE[dificuldade] : "?";
+}
+
+/* ==================== Leitura das linhas do histórico ==================== */
+
+static const char* pular_espacos(const char* p, const char* fim) {
+    while (p < fim && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+    return p;
+}
+
+// String JSON em `p`: conteúdo (escapes mantidos) em ini/n; devolve o byte depois das aspas
+static const char* ler_string(const char* p, const char* fim, const char** ini, size_t* n) {
+    if (p >= fim || *p != '"') return NULL;
+    *ini = ++p;
+    while (p < fim && *p != '"') p += (*p == '\\') ? 2 : 1;
+    if (p >= fim) return NULL;
+    *n = (size_t)(p - *ini);
+    return p + 1;
+}
+
+// Inteiro JSON (sem fração nem expoente)
+static const char* ler_inteiro(const char* p, const char* fim, int64_t* valor) {
+    int negativo = p < fim && *p == '-';
+    if (negativo) p++;
+    if (p >= fim || *p < '0' || *p > '9') return NULL;
+    int64_t v = 0;
+    for (int digitos = 0; p < fim && *p >= '0' && *p <= '9'; p++) {
+        if (++digitos > 18) return NULL;
+        v = v * 10 + (*p - '0');
+    }
+    *valor = negativo ? -v : v;
+    return p;
+}
+
+// Pula um valor de campo desconhecido (string, número, literal, objeto ou vetor)
+static const char* pular_valor(const char* p, const char* fim) {
+    int profundidade = 0;
+    while (p < fim) {
+        if (*p == '"') {
+            const char* ini;
+            size_t n;
+            p = ler_string(p, fim, &ini, &n);
+            if (!p) return NULL;
+            continue;
+        }
+        if (*p == '{' || *p == '[') {
+            profundidade++;
+        } else if (*p == '}' || *p == ']') {
+            if (--profundidade < 0) return NULL;
+        } else if (*p == ',' && profundidade == 0) {
+            return p;
+        }
+        p++;
+    }
+    return profundidade == 0 ? p : NULL;
+}
+
+int resultados_analisar_linha(const char* linha, size_t n, RegistroResultado* r) {
+    const char* p = pular_espacos(linha, linha + n);
+    const char* fim = linha + n;
+    while (fim > p && (fim[-1] == ' ' || fim[-1] == '\t' || fim[-1] == '\r')) fim--;
+    if (p >= fim || *p != '{' || fim[-1] != '}') return 0;    // Linha cortada ou que não é objeto
+    p++;
+    fim--;
+
+    memset(r, 0, sizeof(*r));
+    r->venceu = 1;                                  // Formato antigo: só vitórias eram salvas
+    int tem_palavra = 0, tem_tentativas = 0;
+    while ((p = pular_espacos(p, fim)) < fim) {
+        const char* chave;
+        size_t nc;
+        p = ler_string(p, fim, &chave, &nc);
+        if (!p) return 0;
+        p = pular_espacos(p, fim);
+        if (p >= fim || *p != ':') return 0;
+        p = pular_espacos(p + 1, fim);
+
+        #define CHAVE(nome) (nc == sizeof(nome) - 1 && memcmp(chave, nome, nc) == 0)
+        if (CHAVE("palavra") || CHAVE("dificuldade") || CHAVE("resultado")) {
+            const char* v;
+            size_t nv;
+            p = ler_string(p, fim, &v, &nv);
+            if (!p) return 0;
+            if (CHAVE("palavra")) {
+                if (nv == 0 || nv > PALAVRA_MAX) return 0;
+                for (size_t i = 0; i < nv; i++) {
+                    if (v[i] < 'A' || v[i] > 'Z') return 0;
+                    r->palavra[i] = v[i];
+                }
+                tem_palavra = (int)nv;
+            } else if (CHAVE("dificuldade")) {
+                for (int d = EASY; d <= DEMO; d++) {
+                    if (strlen(NOMES_DIFICULDADE[d]) == nv && memcmp(v, NOMES_DIFICULDADE[d], nv) == 0) {
+                        r->dificuldade = (uint8_t)d;
+                    }
+                }
+                if (!r->dificuldade) return 0;
+            } else if (nv == 7 && memcmp(v, "vitoria", 7) == 0) {
+                r->venceu = 1;
+            } else if (nv == 7 && memcmp(v, "derrota", 7) == 0) {
+                r->venceu = 0;
+            } else {
+                return 0;
+            }
+        } else if (CHAVE("tentativas") || CHAVE("quando") || CHAVE("dicas") || CHAVE("letras") || CHAVE("max")) {
+            int64_t v;
+            p = ler_inteiro(p, fim, &v);
+            if (!p) return 0;
+            if (CHAVE("quando")) {
+                r->quando = v;
+            } else {
+                if (v < 0 || v > 255) return 0;
+                if (CHAVE("tentativas")) { r->tentativas = (uint8_t)v; tem_tentativas = 1; }
+                else if (CHAVE("dicas")) r->dicas = (uint8_t)v;
+                else if (CHAVE("letras")) r->letras = (uint8_t)v;
+                else r->max_tentativas = (uint8_t)v;
+            }
+        } else {
+            p = pular_valor(p, fim);                // Campo desconhecido (versões futuras)
+            if (!p) return 0;
+        }
+        #undef CHAVE
+
+        p = pular_espacos(p, fim);
+        if (p < fim && *p++ != ',') return 0;
+    }
+
+    if (!tem_palavra || !tem_tentativas || !r->dificuldade) return 0;
+    if (r->letras == 0) r->letras = (uint8_t)tem_palavra;
+    return r->letras == tem_palavra;
+}
+
+/*
+    Chamada para cada linha completa (sem o '\n'); linha NULL = linha longa
+    demais ou cortada. Devolve 0 para encerrar a leitura depois desta linha.
+*/
+typedef int (*AoLinha)(void* ctx, const char* linha, size_t n);
+
+/*
+    Percorre as linhas de `f` a partir da posição atual, em blocos, com
+    memória constante (sem mapear o arquivo: funciona igual para históricos
+    maiores que a memória). O fragmento final sem '\n' (linha cortada ou
+    ainda sendo gravada) só é entregue (como NULL) se `incluir_final`.
+    @return: Bytes até o fim da última linha entregue
+*/
+static uint64_t percorrer_linhas(FILE* f, AoLinha ao_linha, void* ctx, int incluir_final) {
+    char* bloco = malloc(RESULTADOS_BLOCO_LEITURA);
+    if (!bloco) return 0;
+
+    uint64_t base = 0;              // Posição (relativa ao início) de bloco[0]
+    uint64_t fim_ultima = 0;        // Fim da última linha completa
+    size_t guardado = 0;            // Início de linha sem '\n' no começo do bloco
+    int longa = 0;                  // Linha maior que o bloco: descartada até o próximo '\n'
+    size_t lidos;
+    while ((lidos = fread(bloco + guardado, 1, RESULTADOS_BLOCO_LEITURA - guardado, f)) > 0) {
+        size_t fim = guardado + lidos, inicio = 0;
+        const char* nl;
+        while ((nl = memchr(bloco + inicio, '\n', fim - inicio)) != NULL) {
+            size_t n = (size_t)(nl - (bloco + inicio));
+            int continuar = ao_linha(ctx, longa ? NULL : bloco + inicio, longa ? 0 : n);
+            longa = 0;
+            inicio += n + 1;
+            fim_ultima = base + inicio;
+            if (!continuar) {
+                free(bloco);
+                return fim_ultima;
+            }
+        }
+        guardado = fim - inicio;
+        if (guardado == RESULTADOS_BLOCO_LEITURA) {
+            longa = 1;                              // Nenhum '\n' em um bloco inteiro
+            guardado = 0;
+            base += RESULTADOS_BLOCO_LEITURA;
+        } else {
+            memmove(bloco, bloco + inicio, guardado);
+            base += inicio;
+        }
+    }
+    if (incluir_final && (guardado > 0 || longa)) ao_linha(ctx, NULL, 0);
+
+    free(bloco);
+    return fim_ultima;
+}
+
+/* ==================== Resumo por dificuldade ==================== */
+
+static const char RESUMO_MAGIC[8] = { 'C', 'O', 'D', 'L', 'E', 'C', 'R', 'S' };
+
+void resultados_acumular(ResumoResultados* resumo, const RegistroResultado* r) {
+    if (r->dificuldade < EASY || r->dificuldade > DEMO) return;
+    ResumoDificuldade* d = &resumo->dificuldades[r->dificuldade];
+    d->jogos++;
+    d->dicas += r->dicas;
+    if (r->venceu) {
+        d->vitorias++;
+        d->tentativas_vitorias += r->tentativas;
+        d->vitorias_em[r->tentativas < RESULTADOS_MAX_TENTATIVAS ? r->tentativas : RESULTADOS_MAX_TENTATIVAS]++;
+        if (++d->sequencia > d->melhor_sequencia) d->melhor_sequencia = d->sequencia;
+    } else {
+        d->sequencia = 0;
+    }
+}
+
+static void resumo_vazio(ResumoResultados* resumo) {
+    memset(resumo, 0, sizeof(*resumo));
+    memcpy(resumo->magic, RESUMO_MAGIC, sizeof(RESUMO_MAGIC));
+    resumo->versao = RESULTADOS_VERSAO_RESUMO;
+}
+
+// FNV-1a 64 dos bytes do resumo antes do checksum
+static uint64_t checksum_resumo(const ResumoResultados* resumo) {
+    const unsigned char* p = (const unsigned char*)resumo;
+    uint64_t h = 14695981039346656037ull;
+    for (size_t i = 0; i < offsetof(ResumoResultados, checksum); i++) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+static void caminho_resumo(char* destino, size_t tamanho, const char* caminho) {
+    snprintf(destino, tamanho, "%s%s", caminho, RESULTADOS_SUFIXO_RESUMO);
+}
+
+// Regrava o resumo inteiro (tamanho fixo) no início de `f`
+static int gravar_resumo(FILE* f, ResumoResultados* resumo, int sincronizar) {
+    resumo->checksum = checksum_resumo(resumo);
+    rewind(f);
+    if (fwrite(resumo, sizeof(*resumo), 1, f) != 1 || fflush(f) != 0) return 0;
+    return !sincronizar || res_fsync(fileno(f)) == 0;
+}
+
+static int gravar_resumo_arquivo(const char* caminho, ResumoResultados* resumo) {
+    char nome[1024];
+    caminho_resumo(nome, sizeof(nome), caminho);
+    FILE* f = fopen(nome, "wb");
+    if (!f) return 0;
+    int ok = gravar_resumo(f, resumo, 0);
+    return fclose(f) == 0 && ok;
+}
+
+// Resumo salvo, se existir e estiver íntegro
+static int ler_resumo(const char* caminho, ResumoResultados* resumo) {
+    char nome[1024];
+    caminho_resumo(nome, sizeof(nome), caminho);
+    FILE* f = fopen(nome, "rb");
+    if (!f) return 0;
+    int ok = fread(resumo, sizeof(*resumo), 1, f) == 1;
+    fclose(f);
+    return ok && memcmp(resumo->magic, RESUMO_MAGIC, sizeof(RESUMO_MAGIC)) == 0 &&
+           resumo->versao == RESULTADOS_VERSAO_RESUMO && resumo->checksum == checksum_resumo(resumo);
+}
+
+static int somar_linha(void* ctx, const char* linha, size_t n) {
+    ResumoResultados* resumo = ctx;
+    RegistroResultado r;
+    if (linha && n == 0) return 1;                  // Linha vazia (não é registro nem erro)
+    if (linha && resultados_analisar_linha(linha, n, &r)) resultados_acumular(resumo, &r);
+    else resumo->ignoradas++;
+    return 1;
+}
+
+int resultados_carregar_resumo(const char* caminho, ResumoResultados* resumo) {
+    FILE* f = fopen(caminho, "rb");
+    if (!f) return 0;
+    if (res_fseek(f, 0, SEEK_END) != 0) {
+        fclose(f);
+        return 0;
+    }
+    uint64_t tamanho = (uint64_t)res_ftell(f);
+
+    // Resumo ausente, corrompido ou de um histórico maior (trocado/truncado): refaz do zero
+    if (!ler_resumo(caminho, resumo) || resumo->bytes_historico > tamanho) resumo_vazio(resumo);
+
+    // Só as linhas anexadas depois do resumo são lidas
+    uint64_t somados = 0;
+    if (resumo->bytes_historico < tamanho && res_fseek(f, (int64_t)resumo->bytes_historico, SEEK_SET) == 0) {
+        somados = percorrer_linhas(f, somar_linha, resumo, 0);
+        resumo->bytes_historico += somados;
+    }
+    fclose(f);
+    if (somados > 0) gravar_resumo_arquivo(caminho, resumo);  // Melhor esforço: a próxima leitura recomeça daqui
+    return 1;
+}
+
+// Janela circular com as últimas partidas lidas
+typedef struct {
+    RegistroResultado* destino;
+    int max, n, proxima;
+    int pular_primeira;             // A leitura começou no meio de uma linha
+} Ultimas;
+
+static int guardar_ultima(void* ctx, const char* linha, size_t n) {
+    Ultimas* u = ctx;
+    if (u->pular_primeira) {
+        u->pular_primeira = 0;
+        return 1;
+    }
+    if (!linha || !resultados_analisar_linha(linha, n, &u->destino[u->proxima])) return 1;
+    u->proxima = (u->proxima + 1) % u->max;
+    if (u->n < u->max) u->n++;
+    return 1;
+}
+
+int resultados_ultimas(const char* caminho, RegistroResultado* destino, int max) {
+    if (max <= 0) return 0;
+    FILE* f = fopen(caminho, "rb");
+    if (!f) return 0;
+
+    // Só o final do arquivo: linhas válidas nunca passam de RESULTADOS_MAX_LINHA
+    int64_t inicio = 0;
+    if (res_fseek(f, 0, SEEK_END) == 0) {
+        inicio = (int64_t)res_ftell(f) - (int64_t)(max + 1) * RESULTADOS_MAX_LINHA;
+        if (inicio < 0) inicio = 0;
+    }
+    Ultimas u = { destino, max, 0, 0, inicio > 0 };
+    if (res_fseek(f, inicio, SEEK_SET) == 0) percorrer_linhas(f, guardar_ultima, &u, 0);
+    fclose(f);
+
+    // Da mais antiga para a mais recente
+    if (u.n == max && u.proxima != 0) {
+        RegistroResultado tmp;
+        for (int k = 0; k < u.proxima; k++) {       // Rotação simples (max é pequeno)
+            tmp = destino[0];
+            memmove(destino, destino + 1, (size_t)(max - 1) * sizeof(*destino));
+            destino[max - 1] = tmp;
+        }
+    }
+    return u.n;
+}
+
+/* ==================== Consulta com filtros ==================== */
+
+int resultados_filtro_aceita(const FiltroResultados* filtro, const RegistroResultado* r) {
+    if (filtro->dificuldade && r->dificuldade != filtro->dificuldade) return 0;
+    if (filtro->resultado >= 0 && r->venceu != filtro->resultado) return 0;
+    if (filtro->desde && r->quando < filtro->desde) return 0;   // Linhas antigas (sem data) ficam de fora
+    if (filtro->ate && (r->quando == 0 || r->quando > filtro->ate)) return 0;
+    for (int i = 0; filtro->palavra[i]; i++) {                  // Prefixo (a palavra inteira também serve)
+        if (i >= r->letras || r->palavra[i] != filtro->palavra[i]) return 0;
+    }
+    return 1;
+}
+
+typedef struct {
+    const FiltroResultados* filtro;
+    uint64_t pular;                 // Registros aceitos ainda a pular antes da página
+    RegistroResultado* destino;
+    int max, n;
+} Consulta;
+
+static int consultar_linha(void* ctx, const char* linha, size_t n) {
+    Consulta* c = ctx;
+    RegistroResultado r;
+    if (!linha || !resultados_analisar_linha(linha, n, &r) || !resultados_filtro_aceita(c->filtro, &r)) return 1;
+    if (c->pular > 0) {
+        c->pular--;
+        return 1;
+    }
+    if (c->destino) c->destino[c->n] = r;
+    return ++c->n < c->max;                         // Página cheia: para logo depois desta linha
+}
+
+int resultados_consultar(const char* caminho, const FiltroResultados* filtro, uint64_t inicio, uint64_t pular,
+                         RegistroResultado* destino, int max, uint64_t* proximo) {
+    if (proximo) *proximo = inicio;
+    if (max <= 0) return 0;
+    FILE* f = fopen(caminho, "rb");
+    if (!f) return 0;
+    Consulta c = { filtro, pular, destino, max, 0 };
+    if (res_fseek(f, (int64_t)inicio, SEEK_SET) == 0) {
+        uint64_t lidos = percorrer_linhas(f, consultar_linha, &c, 0);
+        if (proximo) *proximo = inicio + lidos;
+    }
+    fclose(f);
+    return c.n;
+}
+
+/* ==================== Compactação ==================== */
+
+typedef struct {
+    FILE* saida;
+    ResumoResultados* resumo;
+    uint64_t mantidas, descartadas, bytes;
+    int erro;
+} Compactacao;
+
+static int compactar_linha(void* ctx, const char* linha, size_t n) {
+    Compactacao* c = ctx;
+    RegistroResultado r;
+    if (linha && n == 0) return 1;
+    if (!linha || !resultados_analisar_linha(linha, n, &r)) {
+        c->descartadas++;
+        return 1;
+    }
+    // A linha original é mantida como está (preserva campos desconhecidos)
+    if (fwrite(linha, 1, n, c->saida) != n || fputc('\n', c->saida) == EOF) c->erro = 1;
+    c->bytes += n + 1;
+    c->mantidas++;
+    resultados_acumular(c->resumo, &r);
+    return 1;
+}
+
+int resultados_compactar(const char* caminho, uint64_t* mantidas, uint64_t* descartadas) {
+    char temporario[1024];
+    snprintf(temporario, sizeof(temporario), "%s.tmp", caminho);
+
+    FILE* entrada = fopen(caminho, "rb");
+    if (!entrada) return 0;
+    FILE* saida = fopen(temporario, "wb");
+    if (!saida) {
+        fclose(entrada);
+        return 0;
+    }
+
+    ResumoResultados resumo;
+    resumo_vazio(&resumo);
+    Compactacao c = { saida, &resumo, 0, 0, 0, 0 };
+    percorrer_linhas(entrada, compactar_linha, &c, 1);
+    fclose(entrada);
+
+    // O histórico novo só substitui o antigo depois de inteiro no disco
+    if (fflush(saida) != 0 || res_fsync(fileno(saida)) != 0) c.erro = 1;
+    if (fclose(saida) != 0) c.erro = 1;
+    if (c.erro) {
+        remove(temporario);
+        return 0;
+    }
+    #ifdef _WIN32
+    remove(caminho);                                // rename não substitui arquivos no Windows
+    #endif
+    if (rename(temporario, caminho) != 0) {
+        remove(temporario);
+        return 0;
+    }
+
+    resumo.bytes_historico = c.bytes;
+    if (mantidas) *mantidas = c.mantidas;
+    if (descartadas) *descartadas = c.descartadas;
+    return gravar_resumo_arquivo(caminho, &resumo);
+}
+
+/* ==================== Gravador ==================== */
+
+/*
+    Uma queda no meio de um write pode ter deixado a última linha sem '\n':
+    termina a linha antes de anexar, para o fragmento não corromper o
+    próximo registro (os leitores descartam a linha incompleta)
+*/
+static int terminar_linha_cortada(int fd) {
+    if (res_lseek(fd, 0, SEEK_END) <= 0) return 1;  // Arquivo vazio
+    char ultimo;
+    if (res_lseek(fd, -1, SEEK_END) < 0 || res_read(fd, &ultimo, 1) != 1) return 0;
+    if (ultimo == '\n') return 1;
+    return res_write(fd, "\n", 1) == 1;             // O_APPEND: sempre no final
+}
+
+int resultados_abrir(GravadorResultados* g, const char* caminho,
+                     size_t limite_bytes, double intervalo, int sincronizar) {
+    memset(g, 0, sizeof(*g));
+    g->fd = -1;
+    g->limite_bytes = limite_bytes;
+    g->intervalo = intervalo;
+    g->sincronizar = sincronizar;
+
+    // O lote nunca passa do limite mais uma linha
+    g->capacidade = limite_bytes + RESULTADOS_MAX_LINHA;
+    g->lote = malloc(g->capacidade);
+    if (!g->lote) return 0;
+
+    g->fd = res_open(caminho);
+    if (g->fd < 0 || !terminar_linha_cortada(g->fd) || !resultados_carregar_resumo(caminho, &g->resumo)) {
+        resultados_fechar(g);
+        return 0;
+    }
+
+    // O resumo fica aberto e é regravado no lugar a cada lote
+    char nome[1024];
+    caminho_resumo(nome, sizeof(nome), caminho);
+    g->arquivo_resumo = fopen(nome, "r+b");
+    if (!g->arquivo_resumo) g->arquivo_resumo = fopen(nome, "w+b");
+    if (!g->arquivo_resumo || !gravar_resumo(g->arquivo_resumo, &g->resumo, sincronizar)) {
+        resultados_fechar(g);
+        return 0;
+    }
+    g->resumo_gravado = g->resumo;
+    return 1;
+}
+
+void resultados_de_partida(RegistroResultado* r, const GameState* game, time_t quando) {
+    memset(r, 0, sizeof(*r));
+    r->quando = (int64_t)quando;
+    palavra_secreta(game, r->palavra);
+    r->dificuldade = (uint8_t)game->difficulty;
+    r->letras = (uint8_t)game->letras;
+    r->tentativas = (uint8_t)game->current_attempt;
+    r->max_tentativas = (uint8_t)game->max_attempts;
+    r->dicas = (uint8_t)game->hints_used;
+    r->venceu = (uint8_t)(game->won != 0);
+}
+
+// write completo; um lote só é considerado gravado quando todos os bytes saíram
+static int escrever_tudo(int fd, const char* dados, size_t n) {
+    while (n > 0) {
+        int escrito = (int)res_write(fd, dados, (unsigned)n);
+        if (escrito < 0) {
+            #ifndef _WIN32
+            if (errno == EINTR) continue;
+            #endif
+            return 0;
+        }
+        dados += escrito;
+        n -= (size_t)escrito;
+    }
+    return 1;
+}
+
+int resultados_descarregar(GravadorResultados* g) {
+    if (g->n == 0) return 1;
+    uint64_t inicio = metricas_inicio();            // Write, fsync e resumo
+    int ok = g->fd >= 0 && escrever_tudo(g->fd, g->lote, g->n);
+    if (ok && g->sincronizar) ok = res_fsync(g->fd) == 0;
+
+    if (ok) {
+        g->stats.lotes++;
+        g->stats.bytes += g->n;
+        // O resumo acompanha o histórico: os totais já incluem o lote
+        g->resumo.bytes_historico += g->n;
+        g->resumo_gravado = g->resumo;
+        if (g->arquivo_resumo) gravar_resumo(g->arquivo_resumo, &g->resumo, g->sincronizar);
+        metricas_registrar_bytes(METRICA_RESULTADOS, inicio, g->n);
+    } else {
+        g->stats.erros++;                           // O lote é descartado: não cresce sem limite
+        g->resumo = g->resumo_gravado;              // Totais voltam ao que está no histórico
+        // Parte do lote pode ter sido escrita: corta o histórico de volta ao último lote inteiro,
+        // senão o offset do resumo deixaria de ser o fim do arquivo (e cairia no meio de uma linha)
+        if (g->fd >= 0 && res_truncate(g->fd, (int64_t)g->resumo.bytes_historico) != 0) {
+            // Sem corte: o resumo passa a começar no fim real (as linhas que ficaram não entram nos totais)
+            int64_t fim = (int64_t)res_lseek(g->fd, 0, SEEK_END);
+            if (fim >= 0) {
+                g->resumo.bytes_historico = (uint64_t)fim;
+                g->resumo_gravado = g->resumo;
+                if (g->arquivo_resumo) gravar_resumo(g->arquivo_resumo, &g->resumo, g->sincronizar);
+            }
+        }
+    }
+    g->n = 0;
+    return ok;
+}
+
+int resultados_gravar(GravadorResultados* g, const RegistroResultado* r) {
+    char palavra[PALAVRA_MAX + 1];
+    size_t letras = r->letras <= PALAVRA_MAX ? r->letras : PALAVRA_MAX;
+    memcpy(palavra, r->palavra, letras);
+    palavra[letras] = '\0';
+
+    int n = snprintf(g->lote + g->n, g->capacidade - g->n,
+                     "{\"palavra\": \"%s\", \"tentativas\": %d, \"dificuldade\": \"%s\", \"quando\": %lld, "
+                     "\"dicas\": %d, \"letras\": %d, \"max\": %d, \"resultado\": \"%s\"}\n",
+                     palavra, r->tentativas, resultados_nome_dificuldade(r->dificuldade),
+                     (long long)r->quando, r->dicas, r->letras, r->max_tentativas,
+                     r->venceu ? "vitoria" : "derrota");
+    if (n <= 0 || (size_t)n >= g->capacidade - g->n) return 0;  // Não cabe (nunca acontece com linhas válidas)
+
+    if (g->n == 0) g->pendente_desde = agora_segundos();
+    g->n += (size_t)n;
+    g->stats.registros++;
+    resultados_acumular(&g->resumo, r);
+
+    if (g->n >= g->limite_bytes) return resultados_descarregar(g);
+    return resultados_verificar(g);
+}
+
+int resultados_verificar(GravadorResultados* g) {
+    if (g->n == 0 || agora_segundos() - g->pendente_desde < g->intervalo) return 1;
+    return resultados_descarregar(g);
+}
+
+int resultados_prazo_ms(const GravadorResultados* g) {
+    if (g->n == 0) return -1;
+    double restante = g->pendente_desde + g->intervalo - agora_segundos();
+    return restante <= 0 ? 0 : (int)(restante * 1000.0) + 1;
+}
+
+void resultados_fechar(GravadorResultados* g) {
+    resultados_descarregar(g);
+    if (g->fd >= 0) res_close(g->fd);
+    g->fd = -1;
+    if (g->arquivo_resumo) fclose(g->arquivo_resumo);
+    g->arquivo_resumo = NULL;
+    free(g->lote);
+    g->lote = NULL;
+    g->capacidade = 0;
+}
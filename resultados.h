@@ -0,0 +1,184 @@
+#ifndef RESULTADOS_H
+#define RESULTADOS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "motor.h"
+
+/*
+    Gravador do histórico de partidas (resultados.json)
+
+    Os registros são acumulados em memória e enviados em lotes: um único
+    write quando o lote passa de `limite_bytes` ou quando o registro mais
+    antigo pendente espera há mais de `intervalo` segundos. Opcionalmente
+    cada lote é seguido de fsync.
+
+    Formato: uma linha JSON por partida, terminada em '\n', sempre anexada
+    ao final do arquivo (O_APPEND). Um lote interrompido por uma queda deixa
+    no máximo uma linha incompleta no final; ao abrir, o gravador termina
+    essa linha com '\n' para que ela não se junte à próxima, e os leitores
+    ignoram as linhas que não se completam. Os três primeiros campos seguem
+    o formato antigo (que só tinha vitórias):
+      {"palavra": "CASAS", "tentativas": 4, "dificuldade": "MÉDIO", "quando": 1760000000,
+       "dicas": 1, "letras": 5, "max": 6, "resultado": "vitoria"}
+
+    Resumo (resultados.json.resumo): os totais por dificuldade já somados,
+    em um arquivo binário de tamanho fixo com checksum, regravado a cada
+    lote. Ele guarda quantos bytes do histórico já contabilizou; ao abrir,
+    só as linhas anexadas depois disso são lidas (nenhuma, no caso comum).
+    Um resumo ausente, corrompido ou maior que o histórico é refeito do
+    zero, e resultados_compactar refaz os dois arquivos a partir do histórico.
+*/
+
+#define RESULTADOS_ARQUIVO "resultados.json"
+#define RESULTADOS_LOTE_PADRAO (64 * 1024)  // Bytes acumulados antes de um write
+#define RESULTADOS_INTERVALO_PADRAO 1.0     // Espera máxima de um registro no lote (segundos)
+#define RESULTADOS_MAX_LINHA 256            // Maior linha de um registro
+#define RESULTADOS_SUFIXO_RESUMO ".resumo"  // Resumo = caminho do histórico + sufixo
+#define RESULTADOS_VERSAO_RESUMO 1          // Incrementar ao mudar ResumoResultados
+#define RESULTADOS_MAX_TENTATIVAS 8         // Tentativas distintas no histograma (mais = última faixa)
+
+// Uma partida encerrada
+typedef struct {
+    int64_t quando;                 // Fim da partida (segundos desde 1970, UTC)
+    char palavra[PALAVRA_MAX + 1];  // Palavra-alvo
+    uint8_t dificuldade;            // Difficulty
+    uint8_t letras;                 // Comprimento da palavra
+    uint8_t tentativas;             // Tentativas usadas
+    uint8_t max_tentativas;         // Limite da partida
+    uint8_t dicas;                  // Dicas usadas
+    uint8_t venceu;                 // 1 = vitória, 0 = derrota
+} RegistroResultado;
+
+// Totais de uma dificuldade
+typedef struct {
+    uint64_t jogos;
+    uint64_t vitorias;
+    uint64_t tentativas_vitorias;   // Soma das tentativas das vitórias (para a média)
+    uint64_t dicas;                 // Dicas usadas em todas as partidas
+    uint64_t vitorias_em[RESULTADOS_MAX_TENTATIVAS + 1]; // Histograma: vitórias por tentativas usadas
+    uint32_t sequencia;             // Vitórias seguidas até a última partida
+    uint32_t melhor_sequencia;      // Maior sequência de vitórias
+} ResumoDificuldade;
+
+// Conteúdo do arquivo de resumo
+typedef struct {
+    char magic[8];                  // "CODLECRS"
+    uint32_t versao;                // RESULTADOS_VERSAO_RESUMO
+    uint32_t reservado;             // Sempre 0 (alinhamento)
+    uint64_t bytes_historico;       // Bytes do histórico já somados (sempre fim de linha)
+    uint64_t ignoradas;             // Linhas inválidas ou cortadas encontradas
+    ResumoDificuldade dificuldades[DEMO + 1]; // Índice = Difficulty (0 não usado)
+    uint64_t checksum;              // FNV-1a dos bytes anteriores
+} ResumoResultados;
+
+// Contadores do gravador
+typedef struct {
+    uint64_t registros;             // Registros aceitos
+    uint64_t lotes;                 // Writes (um por lote)
+    uint64_t bytes;                 // Bytes gravados
+    uint64_t erros;                 // Lotes perdidos por erro de escrita
+} ResultadosEstatisticas;
+
+typedef struct {
+    int fd;                         // Arquivo aberto para anexar (-1 = fechado)
+    char* lote;                     // Linhas ainda não gravadas
+    size_t n, capacidade;
+    size_t limite_bytes;            // 0 = grava cada registro na hora
+    double intervalo;               // Espera máxima de um registro pendente (segundos)
+    double pendente_desde;          // Relógio monotônico do registro mais antigo do lote
+    int sincronizar;                // 1 = fsync depois de cada lote
+    FILE* arquivo_resumo;           // Resumo, regravado depois de cada lote
+    ResumoResultados resumo;        // Inclui os registros do lote pendente
+    ResumoResultados resumo_gravado; // Só o que já está no histórico (volta em caso de erro)
+    ResultadosEstatisticas stats;
+} GravadorResultados;
+
+/*
+    Abre (ou cria) o arquivo de resultados para anexar
+    @param limite_bytes: Tamanho do lote (0 = sem lote: um write por registro)
+    @param intervalo: Espera máxima de um registro no lote, em segundos
+    @param sincronizar: 1 = fsync depois de cada lote
+    @return: 1 se o arquivo está pronto
+*/
+int resultados_abrir(GravadorResultados* g, const char* caminho,
+                     size_t limite_bytes, double intervalo, int sincronizar);
+
+// Preenche um registro com o estado final de uma partida
+void resultados_de_partida(RegistroResultado* r, const GameState* game, time_t quando);
+
+// Acrescenta um registro ao lote (gravando o lote se ele encheu ou venceu o prazo)
+int resultados_gravar(GravadorResultados* g, const RegistroResultado* r);
+
+// Grava o lote se o registro mais antigo já esperou `intervalo` segundos
+int resultados_verificar(GravadorResultados* g);
+
+// Milissegundos até o lote vencer o prazo (-1 = nada pendente), para laços de eventos
+int resultados_prazo_ms(const GravadorResultados* g);
+
+// Grava tudo o que está pendente; 0 em caso de erro de escrita
+int resultados_descarregar(GravadorResultados* g);
+
+// Grava o pendente e fecha o arquivo
+void resultados_fechar(GravadorResultados* g);
+
+// Nome de uma dificuldade como aparece no arquivo ("FÁCIL", "MÉDIO", ...)
+const char* resultados_nome_dificuldade(int dificuldade);
+
+/*
+    Interpreta uma linha do histórico (sem o '\n'), em qualquer ordem de
+    campos e ignorando campos desconhecidos; linhas antigas sem "resultado"
+    são vitórias
+    @return: 1 se a linha é um registro completo
+*/
+int resultados_analisar_linha(const char* linha, size_t n, RegistroResultado* r);
+
+// Soma uma partida ao resumo (contagens, histograma e sequências)
+void resultados_acumular(ResumoResultados* resumo, const RegistroResultado* r);
+
+/*
+    Lê o resumo do histórico `caminho`, somando apenas as linhas anexadas
+    depois da última gravação do resumo (e regrava o resumo se somou algo)
+    @return: 1 se o histórico existe e foi lido
+*/
+int resultados_carregar_resumo(const char* caminho, ResumoResultados* resumo);
+
+/*
+    As `max` partidas mais recentes, lidas só do final do histórico
+    @return: Quantas foram encontradas (em ordem, da mais antiga para a mais recente)
+*/
+int resultados_ultimas(const char* caminho, RegistroResultado* destino, int max);
+
+// Filtro de consulta ao histórico; campos zerados (e resultado -1) aceitam tudo
+typedef struct {
+    int dificuldade;                // Difficulty (0 = todas)
+    int resultado;                  // 1 = vitórias, 0 = derrotas, -1 = ambos
+    char palavra[PALAVRA_MAX + 1];  // Prefixo da palavra, em maiúsculas ("" = todas)
+    int64_t desde, ate;             // Datas (segundos desde 1970), inclusive (0 = sem limite)
+} FiltroResultados;
+
+// 1 se o registro passa pelo filtro (com limite de data, linhas antigas sem data não passam)
+int resultados_filtro_aceita(const FiltroResultados* filtro, const RegistroResultado* r);
+
+/*
+    Página de uma consulta: lê o histórico a partir do byte `inicio` (um
+    início de linha; 0 = começo), pula `pular` registros aceitos pelo filtro
+    e guarda os `max` seguintes em `destino` (NULL = só conta). A leitura é
+    em blocos, com memória constante, e para assim que a página enche.
+    @param proximo: Recebe o byte onde a próxima página começa
+    @return: Registros guardados (menos que `max` = fim do histórico)
+*/
+int resultados_consultar(const char* caminho, const FiltroResultados* filtro, uint64_t inicio, uint64_t pular,
+                         RegistroResultado* destino, int max, uint64_t* proximo);
+
+/*
+    Compactação: regrava o histórico só com as linhas válidas (descartando
+    linhas cortadas) e refaz o resumo do zero
+    @return: 1 em caso de sucesso; `mantidas` e `descartadas` recebem as contagens
+*/
+int resultados_compactar(const char* caminho, uint64_t* mantidas, uint64_t* descartadas);
+
+#endif
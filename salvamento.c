@@ -0,0 +1,203 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "salvamento.h"
+
+#ifdef _WIN32
+    #include <io.h>
+    #define salvamento_fsync(fd) _commit(fd)
+#else
+    #include <unistd.h>
+    #define salvamento_fsync(fd) fsync(fd)
+#endif
+
+// Cabeçalho do arquivo (32 bytes, seguido pelas partidas)
+typedef struct {
+    char magic[8];                  // "CODLECSV"
+    uint32_t versao;                // SALVAMENTO_VERSAO
+    uint32_t tamanho_registro;      // sizeof(PartidaSalva)
+    uint64_t quantidade;            // Partidas no arquivo
+    uint64_t checksum;              // FNV-1a das partidas
+} SalvamentoHeader;
+
+#define SALVAMENTO_BUFFER (1 << 20)  // Buffer de escrita: um write a cada ~10 mil partidas
+#define SALVAMENTO_MAX_PARTIDAS (1u << 26) // Limite de sanidade ao ler
+
+static const char SALVAMENTO_MAGIC[8] = { 'C', 'O', 'D', 'L', 'E', 'C', 'S', 'V' };
+
+// FNV-1a 64 aplicado a palavras de 64 bits inteiras (o registro tem tamanho múltiplo de 8)
+static uint64_t checksum_partida(uint64_t h, const PartidaSalva* p) {
+    const uint64_t* palavras = (const uint64_t*)p;
+    for (size_t i = 0; i < sizeof(*p) / sizeof(uint64_t); i++) {
+        h ^= palavras[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+#define CHECKSUM_INICIAL 14695981039346656037ull
+
+void salvamento_codificar(const GameState* game, uint64_t id, PartidaSalva* p) {
+    memset(p, 0, sizeof(*p));
+    p->id = id;
+    p->target = game->target;
+    memcpy(p->guesses, game->guesses, sizeof(p->guesses));
+    p->rng_estado = game->rng.estado;
+    p->rng_incremento = game->rng.incremento;
+    p->last_hint_time = (int64_t)game->last_hint_time;
+    p->letras = (uint8_t)game->letras;
+    p->difficulty = (uint8_t)game->difficulty;
+    p->max_attempts = (uint8_t)game->max_attempts;
+    p->current_attempt = (uint8_t)game->current_attempt;
+    p->hints_used = (uint8_t)game->hints_used;
+    p->reveladas = game->reveladas;
+}
+
+// 1 se a chave tem exatamente `letras` letras válidas (A-Z)
+static int chave_valida(uint64_t chave, int letras) {
+    for (int i = 0; i < letras; i++) {
+        unsigned codigo = (unsigned)KEY_LETTER(chave, i);
+        if (codigo < 1 || codigo > 26) return 0;
+    }
+    return (chave >> (5 * letras)) == 0;
+}
+
+int salvamento_restaurar(const PartidaSalva* p, const Motor* motor, GameState* game) {
+    const Comprimento* comprimento = comprimento_para(p->letras);
+    if (!comprimento || !motor_tem_comprimento(motor, p->letras)) return 0;
+    if (p->difficulty < EASY || p->difficulty > DEMO) return 0;
+    if (p->max_attempts < 1 || p->max_attempts > MAX_ATTEMPTS || p->current_attempt > p->max_attempts) return 0;
+    if (p->hints_used > MAX_HINTS || (p->reveladas >> p->letras) != 0) return 0;
+    if (!chave_valida(p->target, p->letras) || (p->rng_incremento & 1u) == 0) return 0;
+
+    // Refeita à parte: com um registro incoerente, a partida do chamador fica intacta
+    GameState local;
+    memset(&local, 0, sizeof(local));
+    local.motor = motor;
+    local.comprimento = comprimento;
+    local.letras = p->letras;
+    local.difficulty = p->difficulty;
+    local.max_attempts = p->max_attempts;
+    local.target = p->target;
+    for (int i = 0; i < p->letras; i++) local.target_mask |= LETTER_BIT(KEY_LETTER(p->target, i));
+
+    // Feedback, teclado e fim de jogo saem das próprias tentativas, jogadas de novo
+    for (int i = 0; i < p->current_attempt; i++) {
+        char texto[PALAVRA_MAX + 1];
+        if (local.game_over || !chave_valida(p->guesses[i], p->letras)) return 0;
+        for (int j = 0; j < p->letras; j++) texto[j] = KEY_CHAR(p->guesses[i], j);
+        texto[p->letras] = '\0';
+        process_guess(&local, texto);
+    }
+
+    local.hints_used = p->hints_used;
+    local.reveladas = p->reveladas;
+    local.last_hint_time = (time_t)p->last_hint_time;
+    local.rng.estado = p->rng_estado;
+    local.rng.incremento = p->rng_incremento;
+    *game = local;
+    return 1;
+}
+
+int salvamento_iniciar(SalvamentoEscrita* e, const char* caminho) {
+    memset(e, 0, sizeof(*e));
+    if (snprintf(e->caminho, sizeof(e->caminho), "%s", caminho) >= (int)sizeof(e->caminho) ||
+        snprintf(e->temporario, sizeof(e->temporario), "%s.tmp", caminho) >= (int)sizeof(e->temporario)) {
+        return 0;
+    }
+    e->f = fopen(e->temporario, "wb");
+    if (!e->f) return 0;
+    setvbuf(e->f, NULL, _IOFBF, SALVAMENTO_BUFFER);
+    e->checksum = CHECKSUM_INICIAL;
+
+    // Cabeçalho provisório; quantidade e checksum são preenchidos em salvamento_concluir
+    SalvamentoHeader h;
+    memset(&h, 0, sizeof(h));
+    if (fwrite(&h, sizeof(h), 1, e->f) != 1) {
+        salvamento_cancelar(e);
+        return 0;
+    }
+    return 1;
+}
+
+int salvamento_escrever(SalvamentoEscrita* e, const GameState* game, uint64_t id) {
+    PartidaSalva p;
+    salvamento_codificar(game, id, &p);
+    return salvamento_escrever_partida(e, &p);
+}
+
+int salvamento_escrever_partida(SalvamentoEscrita* e, const PartidaSalva* p) {
+    if (fwrite(p, sizeof(*p), 1, e->f) != 1) return 0;
+    e->checksum = checksum_partida(e->checksum, p);
+    e->quantidade++;
+    return 1;
+}
+
+int salvamento_concluir(SalvamentoEscrita* e) {
+    SalvamentoHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, SALVAMENTO_MAGIC, sizeof(SALVAMENTO_MAGIC));
+    h.versao = SALVAMENTO_VERSAO;
+    h.tamanho_registro = (uint32_t)sizeof(PartidaSalva);
+    h.quantidade = e->quantidade;
+    h.checksum = e->checksum;
+
+    int ok = !ferror(e->f) && fseek(e->f, 0, SEEK_SET) == 0 && fwrite(&h, sizeof(h), 1, e->f) == 1;
+    // Dados no disco antes do rename: senão uma queda logo depois pode trocar o anterior por um arquivo vazio
+    ok = ok && fflush(e->f) == 0 && salvamento_fsync(fileno(e->f)) == 0;
+    ok = (fclose(e->f) == 0) && ok;
+    e->f = NULL;
+    if (!ok) {
+        remove(e->temporario);
+        return 0;
+    }
+
+    #ifdef _WIN32
+    remove(e->caminho);                             // rename não sobrescreve no Windows
+    #endif
+    if (rename(e->temporario, e->caminho) != 0) {
+        remove(e->temporario);
+        return 0;
+    }
+    return 1;
+}
+
+void salvamento_cancelar(SalvamentoEscrita* e) {
+    if (e->f) {
+        fclose(e->f);
+        e->f = NULL;
+        remove(e->temporario);
+    }
+}
+
+int64_t salvamento_carregar(const char* caminho, PartidaSalva** partidas) {
+    *partidas = NULL;
+    FILE* f = fopen(caminho, "rb");
+    if (!f) return -1;
+
+    SalvamentoHeader h;
+    if (fread(&h, sizeof(h), 1, f) != 1 ||
+        memcmp(h.magic, SALVAMENTO_MAGIC, sizeof(SALVAMENTO_MAGIC)) != 0 ||
+        h.versao != SALVAMENTO_VERSAO || h.tamanho_registro != sizeof(PartidaSalva) ||
+        h.quantidade > SALVAMENTO_MAX_PARTIDAS) {
+        fclose(f);
+        return -1;
+    }
+    if (h.quantidade == 0) {
+        fclose(f);
+        return h.checksum == CHECKSUM_INICIAL ? 0 : -1;
+    }
+
+    // Uma leitura só para todas as partidas
+    PartidaSalva* vetor = malloc((size_t)h.quantidade * sizeof(PartidaSalva));
+    int ok = vetor && fread(vetor, sizeof(PartidaSalva), (size_t)h.quantidade, f) == h.quantidade;
+    fclose(f);
+    uint64_t checksum = CHECKSUM_INICIAL;
+    for (uint64_t i = 0; ok && i < h.quantidade; i++) checksum = checksum_partida(checksum, &vetor[i]);
+    if (!ok || checksum != h.checksum) {
+        free(vetor);
+        return -1;
+    }
+    *partidas = vetor;
+    return (int64_t)h.quantidade;
+}
@@ -0,0 +1,87 @@
+#ifndef SALVAMENTO_H
+#define SALVAMENTO_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "motor.h"
+
+/*
+    Partidas salvas: um arquivo binário com qualquer número de partidas em
+    andamento (a do jogo no terminal ou todas as sessões do servidor)
+
+    Formato: cabeçalho | PartidaSalva x quantidade
+    Cada partida guarda só o que não pode ser recalculado: palavra-alvo e
+    tentativas empacotadas, dificuldade, dicas (quantas, quais posições e
+    o horário da última, para o intervalo continuar valendo) e o estado do
+    gerador aleatório. Feedback, status das letras e fim de jogo são
+    refeitos ao restaurar, repetindo as tentativas no motor.
+
+    A escrita é em fluxo, em um único arquivo temporário (renomeado no fim:
+    uma falha no meio nunca deixa um arquivo pela metade no lugar do
+    anterior); o checksum cobre todos os registros.
+*/
+
+#define SALVAMENTO_PARTIDA "partida.sav"   // Partida do jogo no terminal
+#define SALVAMENTO_SESSOES "sessoes.sav"   // Sessões do servidor
+#define SALVAMENTO_VERSAO 1                // Incrementar ao mudar PartidaSalva
+
+// Uma partida no arquivo (104 bytes, sem ponteiros)
+typedef struct {
+    uint64_t id;                    // Identificador da sessão no servidor (0 no terminal)
+    uint64_t target;                // Palavra-alvo empacotada
+    uint64_t guesses[MAX_ATTEMPTS]; // Tentativas empacotadas (só as `current_attempt` primeiras valem)
+    uint64_t rng_estado;            // Gerador aleatório da sessão
+    uint64_t rng_incremento;
+    int64_t last_hint_time;         // Horário da última dica (segundos desde 1970; 0 = nunca)
+    uint8_t letras;
+    uint8_t difficulty;
+    uint8_t max_attempts;
+    uint8_t current_attempt;
+    uint8_t hints_used;
+    uint8_t reveladas;              // Bit i = posição i revelada por uma dica
+    uint8_t reservado[2];           // Sempre 0
+} PartidaSalva;
+
+// Escrita em andamento
+typedef struct {
+    FILE* f;
+    char caminho[1024];
+    char temporario[1024];
+    uint64_t quantidade;            // Partidas escritas até agora
+    uint64_t checksum;              // FNV-1a dos registros escritos
+} SalvamentoEscrita;
+
+// Converte uma partida para o formato do arquivo
+void salvamento_codificar(const GameState* game, uint64_t id, PartidaSalva* p);
+
+/*
+    Reconstrói a partida salva sobre o motor (que precisa ter o comprimento
+    da partida carregado)
+    @return: 1 se o registro é coerente e a partida foi restaurada (com 0, `game` não muda)
+*/
+int salvamento_restaurar(const PartidaSalva* p, const Motor* motor, GameState* game);
+
+// Começa um arquivo novo (no temporário `caminho`.tmp)
+int salvamento_iniciar(SalvamentoEscrita* e, const char* caminho);
+
+// Acrescenta uma partida ao arquivo
+int salvamento_escrever(SalvamentoEscrita* e, const GameState* game, uint64_t id);
+
+// Acrescenta uma partida já codificada (ex.: lida de outro arquivo e ainda não restaurada)
+int salvamento_escrever_partida(SalvamentoEscrita* e, const PartidaSalva* p);
+
+// Fecha o cabeçalho e troca o arquivo anterior pelo novo; 0 em caso de erro (o anterior continua)
+int salvamento_concluir(SalvamentoEscrita* e);
+
+// Descarta uma escrita não concluída
+void salvamento_cancelar(SalvamentoEscrita* e);
+
+/*
+    Lê todas as partidas de um arquivo (checksum e versão conferidos)
+    @param partidas: Recebe um vetor alocado (liberar com free) ou NULL se vazio
+    @return: Quantidade de partidas, ou -1 se o arquivo não existe ou é inválido
+*/
+int64_t salvamento_carregar(const char* caminho, PartidaSalva** partidas);
+
+#endif
@@ -0,0 +1,662 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "servidor.h"
+#include "pool.h"
+#include "relogio.h"
+#include "salvamento.h"
+#include "metricas.h"
+
+#ifdef __linux__
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <signal.h>
+    #include <unistd.h>
+    #include <netdb.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <sys/epoll.h>
+    #include <sys/socket.h>
+    #include <sys/un.h>
+#endif
+
+#ifdef __linux__
+
+#define SERVIDOR_MAX_EVENTOS 256        // Eventos tratados por chamada de epoll_wait
+#define SERVIDOR_SAIDA 512              // Respostas pendentes por sessão (bytes)
+#define SERVIDOR_INTERVALO_SALVAMENTO 60.0 // Segundos entre salvamentos automáticos das sessões
+
+// Uma conexão e a partida que ela está jogando
+typedef struct Sessao {
+    int fd;
+    int tem_jogo;                       // 0 até o primeiro NEW
+    uint32_t eventos;                   // Eventos registrados no epoll (EPOLLIN/EPOLLOUT)
+    int fechar;                         // Fecha depois de enviar a saída (QUIT)
+    uint64_t id;                        // Identificador da partida (para RESUME depois de um reinício)
+    uint64_t numero;                    // Número da sessão nesta execução (eventos da gravação)
+    GameState game;
+    char entrada[SERVIDOR_MAX_LINHA];   // Linha parcial ainda sem '\n'
+    int n_entrada;
+    char saida[SERVIDOR_SAIDA];         // Respostas ainda não enviadas
+    int n_saida;
+    int enviado;                        // Bytes de `saida` já enviados
+    struct Sessao* ant;                 // Lista de sessões abertas
+    struct Sessao* prox;
+} Sessao;
+
+typedef struct {
+    const Motor* motor;
+    GravadorResultados* resultados;     // Histórico das partidas encerradas (NULL = não grava)
+    Gravacao* gravacao;                 // Log de eventos para repetição (NULL = não grava)
+    int epoll_fd;
+    int escuta_fd;
+    Sessao* sessoes;
+    Pool pool;                          // Memória das sessões (obter/devolver em O(1))
+    uint64_t semente_base;              // --semente ou sorteada na partida do servidor (entropia do sistema)
+    uint64_t sementes;                  // Contador usado para semear cada sessão
+    Aleatorio ids;                      // Gerador dos identificadores de partida (independente das sementes)
+    const char* arquivo_sessoes;        // Onde as partidas em andamento são salvas (NULL = não salva)
+    PartidaSalva* suspensas;            // Partidas restauradas do arquivo, ordenadas por id
+    uint8_t* retomadas;                 // retomadas[i] = 1 se suspensas[i] já voltou a uma sessão
+    size_t n_suspensas;
+    double proximo_salvamento;          // Relógio monotônico do próximo salvamento automático
+    unsigned long abertas;              // Sessões abertas no momento
+    unsigned long total_sessoes;
+    unsigned long long comandos;
+} Servidor;
+
+static volatile sig_atomic_t servidor_parar = 0;
+
+static volatile sig_atomic_t servidor_salvar = 0;
+
+static void ao_sinal(int sinal) {
+    if (sinal == SIGUSR1) servidor_salvar = 1;
+    else servidor_parar = 1;
+}
+
+static int nao_bloqueante(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+static int eh_unix(const char* endereco) {
+    return strchr(endereco, '/') != NULL;
+}
+
+/*
+    Separa "host:porta" ou "porta" (host padrão 127.0.0.1)
+    @return: 1 se o endereço TCP é válido
+*/
+static int separar_tcp(const char* endereco, char* host, size_t tam_host, const char** porta) {
+    const char* dois_pontos = strrchr(endereco, ':');
+    if (!dois_pontos) {
+        snprintf(host, tam_host, "127.0.0.1");
+        *porta = endereco;
+    } else {
+        size_t n = (size_t)(dois_pontos - endereco);
+        if (n == 0 || n >= tam_host) return 0;
+        memcpy(host, endereco, n);
+        host[n] = '\0';
+        *porta = dois_pontos + 1;
+    }
+    return **porta != '\0';
+}
+
+/*
+    Cria o socket (TCP ou Unix) já ligado ao endereço
+    @param escutar: 1 = bind + listen (servidor), 0 = connect (cliente)
+    @return: Descritor ou -1 em caso de erro
+*/
+static int abrir_socket(const char* endereco, int escutar) {
+    if (eh_unix(endereco)) {
+        struct sockaddr_un un;
+        memset(&un, 0, sizeof(un));
+        un.sun_family = AF_UNIX;
+        if (strlen(endereco) >= sizeof(un.sun_path)) return -1;
+        strcpy(un.sun_path, endereco);
+
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return -1;
+        if (escutar) {
+            unlink(endereco);                       // Socket de uma execução anterior
+            if (bind(fd, (struct sockaddr*)&un, sizeof(un)) != 0 || listen(fd, SOMAXCONN) != 0) {
+                close(fd);
+                return -1;
+            }
+        } else if (connect(fd, (struct sockaddr*)&un, sizeof(un)) != 0) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    char host[256];
+    const char* porta;
+    if (!separar_tcp(endereco, host, sizeof(host), &porta)) return -1;
+
+    struct addrinfo dicas, *lista;
+    memset(&dicas, 0, sizeof(dicas));
+    dicas.ai_family = AF_UNSPEC;
+    dicas.ai_socktype = SOCK_STREAM;
+    dicas.ai_flags = escutar ? AI_PASSIVE : 0;
+    if (getaddrinfo(host, porta, &dicas, &lista) != 0) return -1;
+
+    int fd = -1;
+    for (struct addrinfo* a = lista; a && fd < 0; a = a->ai_next) {
+        fd = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+        if (fd < 0) continue;
+        int um = 1;
+        if (escutar) {
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &um, sizeof(um));
+            if (bind(fd, a->ai_addr, a->ai_addrlen) != 0 || listen(fd, SOMAXCONN) != 0) {
+                close(fd);
+                fd = -1;
+            }
+        } else {
+            if (connect(fd, a->ai_addr, a->ai_addrlen) != 0) {
+                close(fd);
+                fd = -1;
+            } else {
+                // Uma linha por requisição: não esperar para agrupar pacotes
+                setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &um, sizeof(um));
+            }
+        }
+    }
+    freeaddrinfo(lista);
+    return fd;
+}
+
+int servidor_conectar(const char* endereco) {
+    return abrir_socket(endereco, 0);
+}
+
+// Acrescenta uma resposta formatada à saída da sessão
+static void responder(Sessao* s, const char* formato, ...) __attribute__((format(printf, 2, 3)));
+static void responder(Sessao* s, const char* formato, ...) {
+    va_list args;
+    va_start(args, formato);
+    int n = vsnprintf(s->saida + s->n_saida, (size_t)(SERVIDOR_SAIDA - s->n_saida), formato, args);
+    va_end(args);
+    if (n > 0 && s->n_saida + n < SERVIDOR_SAIDA) s->n_saida += n;
+}
+
+static const char* estado_partida(const GameState* game) {
+    if (!game->game_over) return "JOGANDO";
+    return game->won ? "VENCEU" : "PERDEU";
+}
+
+// Letras de uma máscara (LETTER_BIT) em ordem alfabética; "-" se vazia
+static void letras_da_mascara(uint32_t mascara, char saida[27]) {
+    int n = 0;
+    for (uint32_t codigo = 1; codigo <= 26; codigo++) {
+        if (mascara & LETTER_BIT(codigo)) saida[n++] = (char)('A' - 1 + codigo);
+    }
+    if (n == 0) saida[n++] = '-';
+    saida[n] = '\0';
+}
+
+// Registra no log que a partida em andamento da sessão foi deixada (NEW, RESUME ou conexão fechada)
+static void abandonar_partida(Servidor* srv, Sessao* s) {
+    if (s->tem_jogo && !s->game.game_over) gravacao_fim(srv->gravacao, s->numero, &s->game, FIM_ABANDONADA);
+}
+
+// Identificador aleatório de 64 bits, nunca 0 (não revela a semente da partida)
+static uint64_t novo_id(Servidor* srv) {
+    uint64_t id;
+    do {
+        id = ((uint64_t)aleatorio_proximo(&srv->ids) << 32) | aleatorio_proximo(&srv->ids);
+    } while (id == 0);
+    return id;
+}
+
+static int comparar_suspensas(const void* a, const void* b) {
+    uint64_t x = ((const PartidaSalva*)a)->id, y = ((const PartidaSalva*)b)->id;
+    return (x > y) - (x < y);
+}
+
+// Partida restaurada com esse id e ainda não retomada, ou NULL
+static PartidaSalva* buscar_suspensa(Servidor* srv, uint64_t id) {
+    PartidaSalva chave;
+    chave.id = id;
+    PartidaSalva* p = srv->n_suspensas ? bsearch(&chave, srv->suspensas, srv->n_suspensas,
+                                                 sizeof(PartidaSalva), comparar_suspensas) : NULL;
+    return p && !srv->retomadas[p - srv->suspensas] ? p : NULL;
+}
+
+/*
+    Salva todas as partidas em andamento (sessões abertas e partidas
+    restauradas que ainda não foram retomadas) em um único arquivo
+    @return: Partidas salvas, ou -1 em caso de erro (o arquivo anterior continua)
+*/
+static long salvar_sessoes(Servidor* srv) {
+    SalvamentoEscrita e;
+    if (!salvamento_iniciar(&e, srv->arquivo_sessoes)) return -1;
+    int ok = 1;
+    for (Sessao* s = srv->sessoes; s && ok; s = s->prox) {
+        if (s->tem_jogo && !s->game.game_over) ok = salvamento_escrever(&e, &s->game, s->id);
+    }
+    for (size_t i = 0; i < srv->n_suspensas && ok; i++) {
+        if (!srv->retomadas[i]) ok = salvamento_escrever_partida(&e, &srv->suspensas[i]);
+    }
+    if (!ok) {
+        salvamento_cancelar(&e);
+        return -1;
+    }
+    long n = (long)e.quantidade;
+    return salvamento_concluir(&e) ? n : -1;
+}
+
+// Carrega as partidas salvas por uma execução anterior (esperam um RESUME)
+static void carregar_sessoes(Servidor* srv) {
+    int64_t n = salvamento_carregar(srv->arquivo_sessoes, &srv->suspensas);
+    if (n < 0) return;
+    srv->n_suspensas = (size_t)n;
+    srv->retomadas = calloc(srv->n_suspensas ? srv->n_suspensas : 1, 1);
+    if (!srv->retomadas) {
+        free(srv->suspensas);
+        srv->suspensas = NULL;
+        srv->n_suspensas = 0;
+        return;
+    }
+    qsort(srv->suspensas, srv->n_suspensas, sizeof(PartidaSalva), comparar_suspensas);
+    printf("%zu partida(s) em andamento restaurada(s) de %s\n", srv->n_suspensas, srv->arquivo_sessoes);
+}
+
+// Salva as sessões e informa o tempo gasto
+static void salvar_sessoes_relatorio(Servidor* srv) {
+    double inicio = agora_segundos();
+    long n = salvar_sessoes(srv);
+    if (n < 0) printf("Erro ao salvar as partidas em %s\n", srv->arquivo_sessoes);
+    else printf("%ld partida(s) em andamento salva(s) em %s (%.1f ms)\n", n, srv->arquivo_sessoes,
+                (agora_segundos() - inicio) * 1000.0);
+    fflush(stdout);
+    srv->proximo_salvamento = agora_segundos() + SERVIDOR_INTERVALO_SALVAMENTO;
+}
+
+// Executa um comando completo (linha sem o '\n')
+// GUESS: mesma validação e processamento do jogo no terminal
+static void executar_tentativa(Servidor* srv, Sessao* s, const char* arg) {
+    uint64_t inicio = metricas_inicio();
+    int existe = arg && strlen(arg) == (size_t)s->game.letras && check_word_exists(&s->game, arg);
+    metricas_registrar(METRICA_VALIDACAO, inicio);
+    if (!existe) {
+        gravacao_tentativa(srv->gravacao, s->numero, &s->game, arg ? arg : "", 0);
+        responder(s, "ERR palavra_invalida\n");
+        return;
+    }
+    process_guess(&s->game, arg);
+    gravacao_tentativa(srv->gravacao, s->numero, &s->game, arg, 1);
+    if (s->game.game_over) gravacao_fim(srv->gravacao, s->numero, &s->game, FIM_ENCERRADA);
+    if (s->game.game_over && srv->resultados) {
+        RegistroResultado registro;
+        resultados_de_partida(&registro, &s->game, time(NULL));
+        resultados_gravar(srv->resultados, &registro);
+    }
+    int fb[PALAVRA_MAX];
+    char digitos[PALAVRA_MAX + 1], palavra[PALAVRA_MAX + 1];
+    feedback_tentativa(&s->game, s->game.current_attempt - 1, fb);
+    palavra_secreta(&s->game, palavra);
+    for (int i = 0; i < s->game.letras; i++) digitos[i] = (char)('0' + fb[i]);
+    digitos[s->game.letras] = '\0';
+    responder(s, "FB %s %s%s%s\n", digitos,
+              estado_partida(&s->game),
+              s->game.game_over && !s->game.won ? " " : "",
+              s->game.game_over && !s->game.won ? palavra : "");
+}
+
+// STATS [métrica]: números de uma métrica somados entre as threads (nanossegundos)
+static void responder_metricas(Sessao* s, const char* nome) {
+    int m = nome ? metricas_buscar(nome) : METRICA_TENTATIVA;
+    if (!metricas_ativas) {
+        responder(s, "ERR metricas_desligadas\n");
+    } else if (m < 0) {
+        responder(s, "ERR metrica\n");
+    } else {
+        ResumoMetrica r;
+        metricas_resumir((Metrica)m, &r);
+        responder(s, "STATS %s %llu %llu %llu %llu %llu %llu %llu\n", metricas_nome((Metrica)m),
+                  (unsigned long long)r.n, (unsigned long long)(r.n ? r.soma / r.n : 0),
+                  (unsigned long long)r.p50, (unsigned long long)r.p90, (unsigned long long)r.p99,
+                  (unsigned long long)r.maximo, (unsigned long long)r.bytes);
+    }
+}
+
+static void executar_comando(Servidor* srv, Sessao* s, char* linha) {
+    char* cmd = strtok(linha, " \t\r");
+    char* arg = strtok(NULL, " \t\r");
+    char* arg2 = strtok(NULL, " \t\r");
+    srv->comandos++;
+    if (!cmd) return;                               // Linha vazia: nada a responder
+    for (char* c = cmd; *c; c++) *c = (char)toupper((unsigned char)*c);
+
+    if (strcmp(cmd, "NEW") == 0) {
+        int nivel = arg ? atoi(arg) : MEDIUM;
+        if (nivel < EASY || nivel > DEMO) nivel = MEDIUM;
+        int letras = arg2 ? atoi(arg2) : WORD_LENGTH;
+        // Semente distinta por partida: base do servidor + contador (misturados em aleatorio_semear)
+        uint64_t semente = srv->semente_base + srv->sementes++;
+        // Monta a partida à parte: com erro, a atual continua valendo (e não é registrada como abandonada)
+        GameState novo;
+        if (!init_game_letras(&novo, srv->motor, (Difficulty)nivel, letras, semente)) {
+            responder(s, "ERR letras\n");          // Comprimento sem lista carregada
+            return;
+        }
+        abandonar_partida(srv, s);
+        s->game = novo;
+        s->tem_jogo = 1;
+        s->id = novo_id(srv);
+        gravacao_nova(srv->gravacao, s->numero, semente, &s->game);
+        responder(s, "OK %d %016llx\n", s->game.max_attempts, (unsigned long long)s->id);
+    } else if (strcmp(cmd, "RESUME") == 0) {
+        PartidaSalva* p = arg ? buscar_suspensa(srv, strtoull(arg, NULL, 16)) : NULL;
+        GameState retomado;
+        if (!p || !salvamento_restaurar(p, srv->motor, &retomado)) {
+            responder(s, "ERR sem_partida\n");
+            return;
+        }
+        abandonar_partida(srv, s);
+        s->game = retomado;
+        srv->retomadas[p - srv->suspensas] = 1;     // Agora pertence a esta sessão
+        s->tem_jogo = 1;
+        s->id = p->id;
+        gravacao_retomada(srv->gravacao, s->numero, &s->game);
+        responder(s, "OK %d %016llx\n", s->game.max_attempts, (unsigned long long)s->id);
+    } else if (strcmp(cmd, "QUIT") == 0) {
+        responder(s, "BYE\n");
+        s->fechar = 1;
+    } else if (strcmp(cmd, "STATS") == 0) {
+        if (arg) for (char* c = arg; *c; c++) *c = (char)tolower((unsigned char)*c);
+        responder_metricas(s, arg);
+    } else if (strcmp(cmd, "GUESS") != 0 && strcmp(cmd, "HINT") != 0 && strcmp(cmd, "STATUS") != 0 &&
+               strcmp(cmd, "LETTERS") != 0) {
+        responder(s, "ERR comando\n");
+    } else if (!s->tem_jogo) {
+        responder(s, "ERR sem_jogo\n");
+    } else if (strcmp(cmd, "STATUS") == 0) {
+        char reveladas[PALAVRA_MAX + 1];
+        for (int i = 0; i < s->game.letras; i++) {
+            reveladas[i] = s->game.reveladas & (1u << i) ? letra_secreta(&s->game, i) : '_';
+        }
+        reveladas[s->game.letras] = '\0';
+        responder(s, "STATUS %d %d %d %d %s %s\n", (int)s->game.difficulty, s->game.current_attempt,
+                  s->game.max_attempts, s->game.hints_used, estado_partida(&s->game), reveladas);
+    } else if (strcmp(cmd, "LETTERS") == 0) {
+        char verdes[27], amarelas[27], cinzas[27];
+        letras_da_mascara(s->game.letras_verdes, verdes);
+        letras_da_mascara(s->game.letras_amarelas, amarelas);
+        letras_da_mascara(s->game.letras_cinzas, cinzas);
+        responder(s, "LETTERS %s %s %s\n", verdes, amarelas, cinzas);
+    } else if (s->game.game_over) {
+        responder(s, "ERR jogo_encerrado\n");
+    } else if (strcmp(cmd, "HINT") == 0) {
+        time_t agora = time(NULL);
+        if (!can_use_hint(&s->game, agora)) {
+            gravacao_dica(srv->gravacao, s->numero, agora, GRAVACAO_DICA_INDISPONIVEL);
+            responder(s, "ERR dica_indisponivel\n");
+        } else {
+            int pos = use_hint(&s->game, agora);
+            gravacao_dica(srv->gravacao, s->numero, agora, pos < 0 ? GRAVACAO_DICA_SEM_POSICAO : pos);
+            if (pos < 0) responder(s, "ERR sem_dica\n");
+            else responder(s, "HINT %d %c\n", pos + 1, letra_secreta(&s->game, pos));
+        }
+    } else {
+        uint64_t inicio = metricas_inicio();
+        executar_tentativa(srv, s, arg);
+        metricas_registrar(METRICA_TENTATIVA, inicio);
+    }
+}
+
+/*
+    Executa as linhas completas da entrada enquanto houver espaço para as respostas
+    O que sobrar fica na entrada até a saída ser enviada
+*/
+static void processar_entrada(Servidor* srv, Sessao* s) {
+    int inicio = 0;
+    while (!s->fechar && SERVIDOR_SAIDA - s->n_saida > SERVIDOR_MAX_LINHA) {
+        char* fim = memchr(s->entrada + inicio, '\n', (size_t)(s->n_entrada - inicio));
+        if (!fim) break;
+        *fim = '\0';
+        executar_comando(srv, s, s->entrada + inicio);
+        inicio = (int)(fim - s->entrada) + 1;
+    }
+    memmove(s->entrada, s->entrada + inicio, (size_t)(s->n_entrada - inicio));
+    s->n_entrada -= inicio;
+
+    // Linha maior que o buffer nunca terá '\n': descarta e avisa
+    if (s->n_entrada == SERVIDOR_MAX_LINHA && !memchr(s->entrada, '\n', SERVIDOR_MAX_LINHA)) {
+        s->n_entrada = 0;
+        responder(s, "ERR linha_longa\n");
+    }
+}
+
+static void fechar_sessao(Servidor* srv, Sessao* s) {
+    abandonar_partida(srv, s);
+    epoll_ctl(srv->epoll_fd, EPOLL_CTL_DEL, s->fd, NULL);
+    close(s->fd);
+    if (s->ant) s->ant->prox = s->prox;
+    else srv->sessoes = s->prox;
+    if (s->prox) s->prox->ant = s->ant;
+    srv->abertas--;
+    pool_devolver(&srv->pool, s);
+}
+
+/*
+    Envia a saída pendente; o que não couber no socket espera por EPOLLOUT
+    @return: 0 se a sessão deve ser fechada
+*/
+static int enviar_pendente(Servidor* srv, Sessao* s) {
+    while (s->enviado < s->n_saida) {
+        ssize_t n = send(s->fd, s->saida + s->enviado, (size_t)(s->n_saida - s->enviado), MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return 0;
+        }
+        s->enviado += (int)n;
+    }
+    if (s->enviado == s->n_saida) {
+        s->enviado = 0;
+        s->n_saida = 0;
+        if (s->fechar) return 0;
+    }
+
+    // EPOLLOUT só com saída pendente; EPOLLIN só com espaço na entrada (entrada cheia esperando a
+    // saída esvaziar: com EPOLLIN armado, os bytes que ficam no socket acordariam o laço sem parar)
+    uint32_t eventos = (s->n_entrada < SERVIDOR_MAX_LINHA ? EPOLLIN : 0) | (s->n_saida > 0 ? EPOLLOUT : 0);
+    if (eventos != s->eventos) {
+        struct epoll_event ev;
+        ev.events = eventos;
+        ev.data.ptr = s;
+        epoll_ctl(srv->epoll_fd, EPOLL_CTL_MOD, s->fd, &ev);
+        s->eventos = eventos;
+    }
+    return 1;
+}
+
+/*
+    Executa as linhas completas e envia as respostas até não sobrar linha
+    completa na entrada ou até a saída ficar sem espaço (socket cheio)
+    Linhas que esperavam espaço rodam assim que a saída é enviada, sem
+    depender de novos bytes do cliente
+    @return: 0 se a sessão deve ser fechada
+*/
+static int atender(Servidor* srv, Sessao* s) {
+    for (;;) {
+        processar_entrada(srv, s);
+        if (!enviar_pendente(srv, s)) return 0;
+        if (s->fechar || SERVIDOR_SAIDA - s->n_saida <= SERVIDOR_MAX_LINHA ||
+            !memchr(s->entrada, '\n', (size_t)s->n_entrada)) {
+            return 1;
+        }
+    }
+}
+
+// Aceita todas as conexões pendentes no socket de escuta
+static void aceitar(Servidor* srv) {
+    for (;;) {
+        int fd = accept(srv->escuta_fd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) perror("accept");
+            return;
+        }
+        Sessao* s = pool_obter(&srv->pool);
+        if (!s || !nao_bloqueante(fd)) {
+            pool_devolver(&srv->pool, s);
+            close(fd);
+            continue;
+        }
+        memset(s, 0, sizeof(*s));
+        int um = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &um, sizeof(um));   // Ignorado em socket Unix
+        s->fd = fd;
+        s->eventos = EPOLLIN;
+
+        struct epoll_event ev;
+        ev.events = EPOLLIN;
+        ev.data.ptr = s;
+        if (epoll_ctl(srv->epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            pool_devolver(&srv->pool, s);
+            close(fd);
+            continue;
+        }
+        s->prox = srv->sessoes;
+        if (s->prox) s->prox->ant = s;
+        srv->sessoes = s;
+        srv->abertas++;
+        s->numero = ++srv->total_sessoes;
+    }
+}
+
+// Lê o que chegou no socket e executa os comandos completos
+static int ler(Servidor* srv, Sessao* s) {
+    for (;;) {
+        if (s->n_entrada == SERVIDOR_MAX_LINHA) break;   // Espera a saída esvaziar
+        ssize_t n = recv(s->fd, s->entrada + s->n_entrada, (size_t)(SERVIDOR_MAX_LINHA - s->n_entrada), 0);
+        if (n == 0) return 0;                           // Cliente fechou a conexão
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return 0;
+        }
+        s->n_entrada += (int)n;
+        processar_entrada(srv, s);
+    }
+    return 1;
+}
+
+int servidor_executar(const Motor* motor, const char* endereco, GravadorResultados* resultados,
+                      const char* arquivo_sessoes, Gravacao* gravacao, const uint64_t* semente) {
+    Servidor srv;
+    memset(&srv, 0, sizeof(srv));
+    srv.motor = motor;
+    srv.resultados = resultados;
+    srv.semente_base = semente ? *semente : aleatorio_semente_sistema();
+    aleatorio_semear(&srv.ids, aleatorio_semente_sistema());
+    pool_iniciar(&srv.pool, sizeof(Sessao), 0);
+    srv.arquivo_sessoes = arquivo_sessoes;
+    srv.gravacao = gravacao;
+
+    srv.escuta_fd = abrir_socket(endereco, 1);
+    if (srv.escuta_fd < 0 || !nao_bloqueante(srv.escuta_fd)) {
+        printf("Erro: não foi possível escutar em %s\n", endereco);
+        return 1;
+    }
+    srv.epoll_fd = epoll_create1(0);
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.ptr = NULL;                             // NULL = socket de escuta
+    if (srv.epoll_fd < 0 || epoll_ctl(srv.epoll_fd, EPOLL_CTL_ADD, srv.escuta_fd, &ev) != 0) {
+        perror("epoll");
+        close(srv.escuta_fd);
+        return 1;
+    }
+
+    // Sem SA_RESTART: o sinal interrompe epoll_wait e o laço termina
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = ao_sinal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    sigaction(SIGUSR1, &sa, NULL);                  // Salva as partidas em andamento agora
+    signal(SIGPIPE, SIG_IGN);
+
+    if (srv.arquivo_sessoes) carregar_sessoes(&srv);
+    srv.proximo_salvamento = agora_segundos() + SERVIDOR_INTERVALO_SALVAMENTO;
+
+    printf("Servidor escutando em %s (Ctrl+C para encerrar)\n", endereco);
+    fflush(stdout);
+
+    struct epoll_event eventos[SERVIDOR_MAX_EVENTOS];
+    while (!servidor_parar) {
+        // Sem lote pendente o servidor dorme até o próximo evento (ou o próximo salvamento)
+        int prazo = resultados ? resultados_prazo_ms(resultados) : -1;
+        if (srv.arquivo_sessoes) {
+            double restante = srv.proximo_salvamento - agora_segundos();
+            int ms = restante > 0 ? (int)(restante * 1000.0) + 1 : 0;
+            if (prazo < 0 || ms < prazo) prazo = ms;
+        }
+        int n = epoll_wait(srv.epoll_fd, eventos, SERVIDOR_MAX_EVENTOS, prazo);
+        if (resultados) resultados_verificar(resultados);
+        if (srv.arquivo_sessoes && (servidor_salvar || agora_segundos() >= srv.proximo_salvamento)) {
+            servidor_salvar = 0;
+            salvar_sessoes_relatorio(&srv);
+        }
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            perror("epoll_wait");
+            break;
+        }
+        for (int i = 0; i < n; i++) {
+            Sessao* s = eventos[i].data.ptr;
+            if (!s) {
+                aceitar(&srv);
+                continue;
+            }
+            int viva = 1;
+            if (eventos[i].events & (EPOLLERR | EPOLLHUP)) viva = 0;
+            if (viva && (eventos[i].events & EPOLLIN)) viva = ler(&srv, s);
+            if (viva) viva = atender(&srv, s);      // Retoma linhas que esperavam espaço
+            if (!viva) fechar_sessao(&srv, s);
+        }
+    }
+
+    printf("\nServidor encerrado: %lu sessão(ões) atendida(s), %llu comando(s)\n",
+           srv.total_sessoes, srv.comandos);
+    printf("Sessões simultâneas: até %zu (%zu bytes cada, %.1f MB reservados)\n",
+           srv.pool.pico, srv.pool.tamanho, srv.pool.reservado / (1024.0 * 1024.0));
+    if (srv.arquivo_sessoes) salvar_sessoes_relatorio(&srv);   // Retomadas com RESUME no próximo início
+    while (srv.sessoes) fechar_sessao(&srv, srv.sessoes);
+    pool_liberar(&srv.pool);
+    free(srv.suspensas);
+    free(srv.retomadas);
+    close(srv.epoll_fd);
+    close(srv.escuta_fd);
+    if (eh_unix(endereco)) unlink(endereco);
+    return 0;
+}
+
+#else
+
+// epoll só existe no Linux; nos demais sistemas o modo servidor não está disponível
+int servidor_executar(const Motor* motor, const char* endereco, GravadorResultados* resultados,
+                      const char* arquivo_sessoes, Gravacao* gravacao, const uint64_t* semente) {
+    (void)motor;
+    (void)gravacao;
+    (void)semente;
+    (void)endereco;
+    (void)resultados;
+    (void)arquivo_sessoes;
+    printf("Erro: o modo servidor requer Linux (epoll)\n");
+    return 1;
+}
+
+int servidor_conectar(const char* endereco) {
+    (void)endereco;
+    return -1;
+}
+
+#endif
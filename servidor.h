@@ -0,0 +1,55 @@
+#ifndef SERVIDOR_H
+#define SERVIDOR_H
+
+#include "motor.h"
+#include "resultados.h"
+#include "salvamento.h"
+#include "gravacao.h"
+
+/*
+    Servidor de partidas: um único processo hospeda uma sessão (GameState)
+    por conexão, atendidas por um laço de eventos epoll em uma só thread.
+    Conexões ociosas custam apenas a memória da sessão.
+
+    Protocolo em linhas de texto (comandos sem diferença de maiúsculas):
+      NEW [1-4] [letras] -> OK <max_tentativas> <id>   (letras: 5 por padrão; 4, 6, 7, 8 se carregadas)
+      RESUME <id>     -> OK <max_tentativas> <id>   (retoma uma partida salva antes de um reinício)
+      GUESS <palavra> -> FB <feedback> <JOGANDO|VENCEU|PERDEU> [palavra se PERDEU]
+                         feedback = um dígito por letra (2=verde, 1=amarelo, 0=cinza)
+      HINT            -> HINT <posição 1-N> <letra>
+      STATUS          -> STATUS <dificuldade> <tentativas> <max> <dicas> <estado> <reveladas>
+      LETTERS         -> LETTERS <verdes> <amarelas> <cinzas> (letras de cada status, "-" se nenhuma)
+      STATS [métrica] -> STATS <métrica> <n> <média> <p50> <p90> <p99> <máx> <bytes>
+                         (tempos em ns; métrica: tentativa (padrão), validacao, tela, resultados;
+                         só com --stats)
+      QUIT            -> BYE (e fecha a conexão)
+    Erros: ERR <motivo> (comando, letras, sem_jogo, jogo_encerrado, palavra_invalida,
+    dica_indisponivel, sem_dica, sem_partida, metricas_desligadas, metrica, linha_longa)
+
+    Endereço: "porta" ou "host:porta" (TCP) ou caminho de socket Unix (contém '/')
+
+    Toda partida encerrada (vitória ou derrota) vai para o gravador de
+    resultados, que junta os registros em lotes; o laço de eventos acorda
+    no prazo do lote para gravá-lo mesmo sem tráfego
+
+    As partidas em andamento são salvas em um único arquivo (salvamento.h)
+    a cada SERVIDOR_INTERVALO_SALVAMENTO segundos, ao receber SIGUSR1 e ao
+    encerrar. No início seguinte elas são carregadas e cada cliente retoma
+    a sua com RESUME e o id recebido em NEW (hexadecimal, 16 dígitos)
+*/
+
+#define SERVIDOR_ENDERECO_PADRAO "7777"
+#define SERVIDOR_MAX_LINHA 128          // Maior linha de comando aceita
+
+// Atende conexões até receber SIGINT/SIGTERM; retorna o código de saída
+// `resultados` pode ser NULL (partidas não são gravadas)
+// `arquivo_sessoes` pode ser NULL (partidas em andamento não são salvas nem restauradas)
+// `gravacao` pode ser NULL (eventos das sessões não são gravados para repetição)
+// `semente` pode ser NULL (entropia do sistema); com --semente N, o n-ésimo NEW usa a semente N+n
+int servidor_executar(const Motor* motor, const char* endereco, GravadorResultados* resultados,
+                      const char* arquivo_sessoes, Gravacao* gravacao, const uint64_t* semente);
+
+// Abre uma conexão de cliente com o servidor (bloqueante); -1 em caso de erro
+int servidor_conectar(const char* endereco);
+
+#endif
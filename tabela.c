@@ -0,0 +1,285 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tabela.h"
+#include "feedback.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <pthread.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+// Cabeçalho do arquivo de cache (32 bytes, seguido pela matriz n x n)
+typedef struct {
+    char magic[8];          // "CODLECPT"
+    uint32_t versao;        // TABELA_VERSAO
+    uint32_t word_length;   // Comprimento das palavras usadas
+    uint32_t n;             // Dimensão da matriz
+    uint32_t reservado;     // Sempre 0 (alinhamento)
+    uint64_t hash;          // tabela_hash_palavras das listas usadas
+} TabelaHeader;
+
+static const char TABELA_MAGIC[8] = { 'C', 'O', 'D', 'L', 'E', 'C', 'P', 'T' };
+
+uint64_t tabela_hash_palavras(const uint32_t* words, uint32_t n) {
+    uint64_t h = 14695981039346656037ull;          // Base FNV-1a 64 bits
+    for (uint32_t i = 0; i < n; i++) {
+        for (int b = 0; b < 4; b++) {              // Bytes em ordem fixa (independe do endian)
+            h ^= (words[i] >> (8 * b)) & 0xFF;
+            h *= 1099511628211ull;
+        }
+    }
+    return h;
+}
+
+int tabela_threads_padrao(void) {
+    #ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+    #else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+    #endif
+}
+
+// Verifica se o cabeçalho corresponde às listas atuais
+static int header_valido(const TabelaHeader* h, uint32_t n, uint64_t hash) {
+    return memcmp(h->magic, TABELA_MAGIC, sizeof(TABELA_MAGIC)) == 0 &&
+           h->versao == TABELA_VERSAO &&
+           h->word_length == WORD_LENGTH &&
+           h->n == n &&
+           h->hash == hash;
+}
+
+/*
+    Tenta abrir um cache existente
+    Em sistemas POSIX o arquivo é mapeado com mmap (nenhuma cópia é feita);
+    no Windows é lido para a memória
+    @return: 1 se o cache é válido e foi aberto, 0 caso contrário
+*/
+static int abrir_cache(PatternTable* t, uint32_t n, uint64_t hash, const char* caminho) {
+    size_t esperado = sizeof(TabelaHeader) + (size_t)n * n;
+
+    #ifdef _WIN32
+    FILE* file = fopen(caminho, "rb");
+    if (!file) return 0;
+    TabelaHeader h;
+    if (fread(&h, sizeof(h), 1, file) != 1 || !header_valido(&h, n, hash)) {
+        fclose(file);
+        return 0;
+    }
+    uint8_t* m = malloc((size_t)n * n);
+    if (!m || fread(m, 1, (size_t)n * n, file) != (size_t)n * n) {
+        free(m);
+        fclose(file);
+        return 0;
+    }
+    fclose(file);
+    t->owned = m;
+    t->owned_size = (size_t)n * n;
+    t->mapped = 0;
+    t->matrix = m;
+    #else
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) return 0;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size != esperado) {
+        close(fd);
+        return 0;
+    }
+    void* map = mmap(NULL, esperado, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);                                      // O mapeamento continua válido sem o fd
+    if (map == MAP_FAILED) return 0;
+    if (!header_valido((const TabelaHeader*)map, n, hash)) {
+        munmap(map, esperado);
+        return 0;
+    }
+    t->owned = map;
+    t->owned_size = esperado;
+    t->mapped = 1;
+    t->matrix = (const uint8_t*)map + sizeof(TabelaHeader);
+    #endif
+
+    (void)esperado;
+    t->n = n;
+    t->from_cache = 1;
+    return 1;
+}
+
+// Faixa de linhas calculada por uma thread
+typedef struct {
+    const uint32_t* words;
+    uint32_t n;
+    uint8_t* matrix;
+    uint32_t first;     // Primeira linha (inclusive)
+    uint32_t last;      // Última linha (exclusive)
+} TabelaFaixa;
+
+#ifdef _WIN32
+static DWORD WINAPI calcular_faixa(LPVOID arg) {
+#else
+static void* calcular_faixa(void* arg) {
+#endif
+    TabelaFaixa* f = arg;
+    for (uint32_t g = f->first; g < f->last; g++) {
+        feedback_score(f->words[g], f->words, f->n, f->matrix + (size_t)g * f->n);
+    }
+    return 0;
+}
+
+/*
+    Calcula a matriz completa dividindo as linhas entre `threads` threads
+    Todas as linhas têm o mesmo custo, então a divisão estática é equilibrada
+*/
+static void calcular_matriz(const uint32_t* words, uint32_t n, uint8_t* matrix, int threads) {
+    if (threads < 1) threads = 1;
+    if ((uint32_t)threads > n) threads = n > 0 ? (int)n : 1;
+
+    TabelaFaixa* faixas = calloc((size_t)threads, sizeof(TabelaFaixa));
+    #ifdef _WIN32
+    HANDLE* ids = calloc((size_t)threads, sizeof(HANDLE));
+    #else
+    pthread_t* ids = calloc((size_t)threads, sizeof(pthread_t));
+    #endif
+    if (!faixas || !ids) {
+        // Sem memória para as threads: calcula tudo na thread atual
+        TabelaFaixa tudo = { words, n, matrix, 0, n };
+        calcular_faixa(&tudo);
+        free(faixas);
+        free(ids);
+        return;
+    }
+
+    uint32_t passo = (n + (uint32_t)threads - 1) / (uint32_t)threads;
+    for (int i = 0; i < threads; i++) {
+        faixas[i].words = words;
+        faixas[i].n = n;
+        faixas[i].matrix = matrix;
+        faixas[i].first = (uint32_t)i * passo < n ? (uint32_t)i * passo : n;
+        faixas[i].last = faixas[i].first + passo < n ? faixas[i].first + passo : n;
+    }
+
+    // Faixa 0 roda na thread atual; as demais em threads novas
+    int iniciadas = 0;
+    for (int i = 1; i < threads; i++) {
+        #ifdef _WIN32
+        ids[i] = CreateThread(NULL, 0, calcular_faixa, &faixas[i], 0, NULL);
+        if (!ids[i]) break;
+        #else
+        if (pthread_create(&ids[i], NULL, calcular_faixa, &faixas[i]) != 0) break;
+        #endif
+        iniciadas = i;
+    }
+    calcular_faixa(&faixas[0]);
+    for (int i = iniciadas + 1; i < threads; i++) {
+        calcular_faixa(&faixas[i]);                 // Faixas cuja thread não pôde ser criada
+    }
+
+    for (int i = 1; i <= iniciadas; i++) {
+        #ifdef _WIN32
+        WaitForSingleObject(ids[i], INFINITE);
+        CloseHandle(ids[i]);
+        #else
+        pthread_join(ids[i], NULL);
+        #endif
+    }
+    free(faixas);
+    free(ids);
+}
+
+/*
+    Grava a matriz em um arquivo temporário e renomeia para o nome final,
+    para que outra execução nunca veja um cache escrito pela metade
+    @return: 1 em caso de sucesso, 0 caso contrário
+*/
+static int gravar_cache(const uint8_t* matrix, uint32_t n, uint64_t hash, const char* caminho) {
+    char temporario[1024];
+    if (snprintf(temporario, sizeof(temporario), "%s.tmp", caminho) >= (int)sizeof(temporario)) return 0;
+
+    FILE* file = fopen(temporario, "wb");
+    if (!file) return 0;
+
+    TabelaHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, TABELA_MAGIC, sizeof(TABELA_MAGIC));
+    h.versao = TABELA_VERSAO;
+    h.word_length = WORD_LENGTH;
+    h.n = n;
+    h.hash = hash;
+
+    int ok = fwrite(&h, sizeof(h), 1, file) == 1 &&
+             fwrite(matrix, 1, (size_t)n * n, file) == (size_t)n * n;
+    ok = (fclose(file) == 0) && ok;
+    if (!ok) {
+        remove(temporario);
+        return 0;
+    }
+
+    #ifdef _WIN32
+    remove(caminho);                                // rename não sobrescreve no Windows
+    #endif
+    if (rename(temporario, caminho) != 0) {
+        remove(temporario);
+        return 0;
+    }
+    return 1;
+}
+
+/*
+    Abre a tabela de padrões para as palavras informadas
+    1. Se `caminho` contém um cache com mesmo versão/hash/tamanho, mapeia o arquivo
+    2. Caso contrário calcula a matriz com `threads` threads, grava o cache e o mapeia
+    Se não for possível gravar o arquivo, a matriz calculada fica em memória
+    @return: 1 em caso de sucesso, 0 se faltar memória
+*/
+int tabela_abrir(PatternTable* t, const uint32_t* words, uint32_t n, const char* caminho, int threads) {
+    memset(t, 0, sizeof(*t));
+    uint64_t hash = tabela_hash_palavras(words, n);
+
+    if (caminho && abrir_cache(t, n, hash, caminho)) {
+        return 1;
+    }
+
+    uint8_t* matrix = malloc((size_t)n * n + 1);    // +1 evita malloc(0) com listas vazias
+    if (!matrix) return 0;
+    calcular_matriz(words, n, matrix, threads);
+
+    // Prefere servir a partir do arquivo mapeado (páginas compartilhadas entre processos)
+    if (caminho && gravar_cache(matrix, n, hash, caminho) && abrir_cache(t, n, hash, caminho)) {
+        free(matrix);
+        t->from_cache = 0;
+        return 1;
+    }
+
+    t->matrix = matrix;
+    t->n = n;
+    t->owned = matrix;
+    t->owned_size = (size_t)n * n;
+    t->mapped = 0;
+    t->from_cache = 0;
+    return 1;
+}
+
+int tabela_carregar(PatternTable* t, const uint32_t* words, uint32_t n, const char* caminho) {
+    memset(t, 0, sizeof(*t));
+    return abrir_cache(t, n, tabela_hash_palavras(words, n), caminho);
+}
+
+void tabela_fechar(PatternTable* t) {
+    #ifndef _WIN32
+    if (t->mapped) {
+        munmap(t->owned, t->owned_size);
+    } else
+    #endif
+    {
+        free(t->owned);
+    }
+    memset(t, 0, sizeof(*t));
+}
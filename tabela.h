@@ -0,0 +1,43 @@
+#ifndef TABELA_H
+#define TABELA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+    Tabela pré-computada de padrões de feedback (tentativa x palavra-alvo)
+    Um byte por par: matrix[g * n + t] = feedback_pattern(words[g], words[t])
+    O arquivo de cache é versionado e identificado por um hash das listas
+*/
+
+#define TABELA_ARQUIVO "padroes.bin"   // Nome padrão do arquivo de cache
+#define TABELA_VERSAO 1                 // Incrementar ao mudar o formato do arquivo
+
+typedef struct {
+    const uint8_t* matrix;  // Matriz n x n (linha = tentativa, coluna = palavra-alvo)
+    uint32_t n;             // Quantidade de palavras em cada eixo
+    int from_cache;         // 1 se veio do arquivo (mmap), 0 se foi calculada agora
+    void* owned;            // Memória própria (mmap ou malloc) a liberar em tabela_fechar
+    size_t owned_size;      // Tamanho da região mapeada
+    int mapped;             // 1 se owned é um mmap, 0 se é malloc
+} PatternTable;
+
+// Acesso direto a um padrão: uma única leitura de byte
+#define TABELA_PADRAO(t, g, a) ((t)->matrix[(size_t)(g) * (t)->n + (a)])
+
+// Hash (FNV-1a 64 bits) das chaves empacotadas, grava no cabeçalho do arquivo
+uint64_t tabela_hash_palavras(const uint32_t* words, uint32_t n);
+
+// Abre apenas o cache existente (sem calcular); retorna 0 se ausente ou desatualizado
+int tabela_carregar(PatternTable* t, const uint32_t* words, uint32_t n, const char* caminho);
+
+// Abre o cache em `caminho` se for válido para `words`; senão calcula em paralelo e grava
+int tabela_abrir(PatternTable* t, const uint32_t* words, uint32_t n, const char* caminho, int threads);
+
+// Libera a tabela (munmap ou free)
+void tabela_fechar(PatternTable* t);
+
+// Número de threads de hardware disponíveis (mínimo 1)
+int tabela_threads_padrao(void);
+
+#endif
@@ -0,0 +1,260 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tela.h"
+
+#ifdef _WIN32
+    #include <io.h>
+    #define tela_write _write
+#else
+    #include <errno.h>
+    #include <unistd.h>
+    #define tela_write write
+#endif
+
+static const Celula CELULA_VAZIA = { { ' ', 0, 0, 0 }, 0, 1, { 0, 0 } };
+
+static void preencher_vazio(Celula grade[TELA_LINHAS][TELA_COLUNAS]) {
+    for (int l = 0; l < TELA_LINHAS; l++) {
+        for (int c = 0; c < TELA_COLUNAS; c++) grade[l][c] = CELULA_VAZIA;
+    }
+}
+
+int tela_iniciar(Tela* tela) {
+    memset(tela, 0, sizeof(*tela));
+    tela->n_estilos = 1;                        // Estilo 0: sem formatação (string vazia)
+    tela->saida_capacidade = 8192;
+    tela->saida = malloc(tela->saida_capacidade);
+    if (!tela->saida) return 0;
+    preencher_vazio(tela->anterior);
+    tela_limpar(tela);
+    return 1;
+}
+
+void tela_liberar(Tela* tela) {
+    free(tela->saida);
+    tela->saida = NULL;
+}
+
+void tela_limpar(Tela* tela) {
+    preencher_vazio(tela->atual);
+    tela->linha = 0;
+    tela->coluna = 0;
+    tela->estilo = 0;
+}
+
+void tela_invalidar(Tela* tela) {
+    tela->valida = 0;
+}
+
+/*
+    Estilo resultante de aplicar uma sequência SGR ao estilo atual
+    "\033[0m" (ou "\033[m") volta ao estilo 0; as demais se acumulam, como
+    no terminal. Se a tabela encher, o texto segue sem o novo atributo.
+*/
+static uint8_t aplicar_sgr(Tela* tela, const char* sgr, size_t n, const char* parametros, size_t np) {
+    if (np == 0 || (np == 1 && parametros[0] == '0')) return 0;
+
+    char combinado[TELA_ESTILO_TAMANHO];
+    size_t base = strlen(tela->estilos[tela->estilo]);
+    if (base + n >= sizeof(combinado)) return tela->estilo;
+    memcpy(combinado, tela->estilos[tela->estilo], base);
+    memcpy(combinado + base, sgr, n);
+    combinado[base + n] = '\0';
+
+    for (int i = 0; i < tela->n_estilos; i++) {
+        if (strcmp(tela->estilos[i], combinado) == 0) return (uint8_t)i;
+    }
+    if (tela->n_estilos >= TELA_MAX_ESTILOS) return tela->estilo;
+    strcpy(tela->estilos[tela->n_estilos], combinado);
+    return (uint8_t)tela->n_estilos++;
+}
+
+// Colunas ocupadas por um code point (emoji e CJK ocupam duas)
+static int largura_caractere(uint32_t cp) {
+    if (cp >= 0x1F000 ||
+        (cp >= 0x2E80 && cp <= 0xA4CF) ||
+        (cp >= 0xAC00 && cp <= 0xD7A3) ||
+        (cp >= 0xFF00 && cp <= 0xFF60)) {
+        return 2;
+    }
+    return 1;
+}
+
+// Coloca um caractere na posição de composição e avança
+static void colocar(Tela* tela, const char* g, int n, int largura) {
+    int l = tela->linha, c = tela->coluna;
+    if (l < TELA_LINHAS && c + largura <= TELA_COLUNAS) {
+        Celula* cel = &tela->atual[l][c];
+        memset(cel, 0, sizeof(*cel));
+        memcpy(cel->g, g, (size_t)n);
+        cel->estilo = tela->estilo;
+        cel->largura = (uint8_t)largura;
+        if (largura == 2) {
+            Celula* direita = &tela->atual[l][c + 1];
+            memset(direita, 0, sizeof(*direita));   // Metade direita: não é desenhada
+            direita->estilo = tela->estilo;
+        }
+    }
+    tela->coluna += largura;
+}
+
+void tela_printf(Tela* tela, const char* formato, ...) {
+    char local[1024];
+    char* texto = local;
+    va_list args;
+    va_start(args, formato);
+    int n = vsnprintf(local, sizeof(local), formato, args);
+    va_end(args);
+    if (n < 0) return;
+    if ((size_t)n >= sizeof(local)) {           // Texto longo: formata de novo em memória própria
+        texto = malloc((size_t)n + 1);
+        if (!texto) return;
+        va_start(args, formato);
+        vsnprintf(texto, (size_t)n + 1, formato, args);
+        va_end(args);
+    }
+
+    const unsigned char* p = (const unsigned char*)texto;
+    for (int i = 0; i < n; ) {
+        unsigned c = p[i];
+        if (c == '\n') {
+            tela->linha++;
+            tela->coluna = 0;
+            i++;
+        } else if (c == '\r') {
+            tela->coluna = 0;
+            i++;
+        } else if (c == '\033' && i + 1 < n && p[i + 1] == '[') {
+            // Sequência CSI: só SGR (termina em 'm') muda o estilo; as demais são ignoradas
+            int fim = i + 2;
+            while (fim < n && (p[fim] < 0x40 || p[fim] > 0x7E)) fim++;
+            if (fim < n && p[fim] == 'm') {
+                tela->estilo = aplicar_sgr(tela, texto + i, (size_t)(fim + 1 - i),
+                                           texto + i + 2, (size_t)(fim - i - 2));
+            }
+            i = fim + 1;
+        } else if (c < 0x20 || c == 0x7F) {
+            i++;                                // Outros controles não ocupam célula
+        } else {
+            int bytes = c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : c >= 0xC0 ? 2 : 1;
+            if (i + bytes > n) bytes = n - i;
+            uint32_t cp = bytes == 1 ? c : (c & (0x3Fu >> (bytes - 1)));
+            for (int k = 1; k < bytes; k++) cp = (cp << 6) | (p[i + k] & 0x3Fu);
+            colocar(tela, texto + i, bytes, largura_caractere(cp));
+            i += bytes;
+        }
+    }
+
+    if (texto != local) free(texto);
+}
+
+// Acrescenta bytes ao quadro a enviar
+static void anexar(Tela* tela, const char* dados, size_t n) {
+    if (tela->saida_n + n > tela->saida_capacidade) {
+        size_t capacidade = tela->saida_capacidade * 2;
+        while (capacidade < tela->saida_n + n) capacidade *= 2;
+        char* nova = realloc(tela->saida, capacidade);
+        if (!nova) return;                      // Sem memória: o quadro sai incompleto
+        tela->saida = nova;
+        tela->saida_capacidade = capacidade;
+    }
+    memcpy(tela->saida + tela->saida_n, dados, n);
+    tela->saida_n += n;
+}
+
+static void anexar_cursor(Tela* tela, int linha, int coluna) {
+    char seq[24];
+    int n = snprintf(seq, sizeof(seq), "\033[%d;%dH", linha + 1, coluna + 1);
+    anexar(tela, seq, (size_t)n);
+}
+
+/*
+    Pulo curto para a frente na mesma linha: reenviar as poucas células
+    iguais do meio custa menos que uma sequência de cursor (6 a 8 bytes),
+    desde que elas tenham o estilo corrente e largura 1
+    @return: 1 se o cursor chegou a `ate` reescrevendo as células
+*/
+static int reescrever_intervalo(Tela* tela, int linha, int de, int ate, int estilo) {
+    if (de < 0 || de > ate || ate - de > 4) return 0;
+    for (int c = de; c < ate; c++) {
+        const Celula* cel = &tela->atual[linha][c];
+        if (cel->estilo != estilo || cel->largura != 1) return 0;
+    }
+    for (int c = de; c < ate; c++) {
+        const Celula* cel = &tela->atual[linha][c];
+        anexar(tela, cel->g, strnlen(cel->g, sizeof(cel->g)));
+    }
+    return 1;
+}
+
+// write completo (o terminal pode aceitar só parte dos bytes)
+static void escrever_tudo(int fd, const char* dados, size_t n) {
+    while (n > 0) {
+        int escrito = (int)tela_write(fd, dados, (unsigned)n);
+        if (escrito < 0) {
+            #ifndef _WIN32
+            if (errno == EINTR) continue;
+            #endif
+            return;
+        }
+        dados += escrito;
+        n -= (size_t)escrito;
+    }
+}
+
+size_t tela_apresentar(Tela* tela, int fd) {
+    tela->saida_n = 0;
+    int completo = !tela->valida;
+    if (completo) {
+        // Redesenho completo: a partir de uma tela limpa só as células não vazias importam
+        anexar(tela, "\033[0m\033[H\033[2J", 11);
+        preencher_vazio(tela->anterior);
+    }
+
+    int cur_l = completo ? 0 : tela->cursor_linha;  // Posição conhecida do cursor do terminal
+    int cur_c = completo ? 0 : tela->cursor_coluna;
+    int estilo = 0;                             // Todo quadro termina com o estilo 0
+    for (int l = 0; l < TELA_LINHAS; l++) {
+        for (int c = 0; c < TELA_COLUNAS; c++) {
+            const Celula* cel = &tela->atual[l][c];
+            if (memcmp(cel, &tela->anterior[l][c], sizeof(*cel)) == 0) continue;
+            if (cel->largura == 0) continue;    // Metade direita: sai junto com a esquerda
+
+            if (cur_l != l || cur_c != c) {
+                if (cur_l != l || !reescrever_intervalo(tela, l, cur_c, c, estilo)) anexar_cursor(tela, l, c);
+            }
+            if (estilo != cel->estilo) {
+                anexar(tela, "\033[0m", 4);
+                anexar(tela, tela->estilos[cel->estilo], strlen(tela->estilos[cel->estilo]));
+                estilo = cel->estilo;
+            }
+            anexar(tela, cel->g, strnlen(cel->g, sizeof(cel->g)));
+            cur_l = l;
+            cur_c = c + cel->largura;
+        }
+    }
+    if (estilo != 0) anexar(tela, "\033[0m", 4);
+
+    // Cursor onde a composição terminou (ex.: depois do texto digitado)
+    int linha = tela->linha < TELA_LINHAS ? tela->linha : TELA_LINHAS - 1;
+    int coluna = tela->coluna < TELA_COLUNAS ? tela->coluna : TELA_COLUNAS - 1;
+    if (cur_l != linha || cur_c != coluna) anexar_cursor(tela, linha, coluna);
+
+    memcpy(tela->anterior, tela->atual, sizeof(tela->atual));
+    tela->valida = 1;
+    tela->cursor_linha = linha;
+    tela->cursor_coluna = coluna;
+
+    fflush(stdout);                             // Saída anterior via stdio vem antes do quadro
+    escrever_tudo(fd, tela->saida, tela->saida_n);
+
+    tela->stats.quadros++;
+    tela->stats.completos += (uint64_t)completo;
+    tela->stats.bytes += tela->saida_n;
+    tela->stats.bytes_ultimo = tela->saida_n;
+    if (tela->saida_n > tela->stats.bytes_maximo) tela->stats.bytes_maximo = tela->saida_n;
+    return tela->saida_n;
+}
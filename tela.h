@@ -0,0 +1,75 @@
+#ifndef TELA_H
+#define TELA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+    Renderizador diferencial do terminal
+
+    Cada quadro é composto em uma grade de células (tela_limpar + tela_printf,
+    que entende '\n' e as sequências de cor ANSI "\033[...m" já usadas pelo
+    jogo) e comparado com o quadro anterior: tela_apresentar emite só os
+    movimentos de cursor e as células que mudaram, em um único write.
+
+    Qualquer saída feita fora do renderizador (printf, clear_screen) deixa o
+    terminal diferente do último quadro: chame tela_invalidar para que o
+    próximo quadro seja redesenhado por inteiro.
+*/
+
+#define TELA_LINHAS 32          // Linhas da grade (o que passar disso é cortado)
+#define TELA_COLUNAS 100        // Colunas da grade
+#define TELA_MAX_ESTILOS 32     // Combinações distintas de cor/atributo por tela
+#define TELA_ESTILO_TAMANHO 32  // Bytes das sequências SGR de um estilo
+
+// Uma posição da grade: um caractere UTF-8 e o estilo em que é desenhado
+typedef struct {
+    char g[4];                  // Bytes UTF-8 do caractere (g[0] = 0: metade direita de um caractere largo)
+    uint8_t estilo;             // Índice em Tela.estilos (0 = sem formatação)
+    uint8_t largura;            // Colunas ocupadas no terminal (1 ou 2)
+    uint8_t reservado[2];       // Sempre 0 (células comparadas com memcmp)
+} Celula;
+
+// Estatísticas de saída do renderizador
+typedef struct {
+    uint64_t quadros;           // Quadros apresentados
+    uint64_t completos;         // Quadros que redesenharam a tela inteira
+    uint64_t bytes;             // Total de bytes escritos
+    size_t bytes_ultimo;        // Bytes do último quadro
+    size_t bytes_maximo;        // Maior quadro
+} TelaEstatisticas;
+
+typedef struct {
+    Celula atual[TELA_LINHAS][TELA_COLUNAS];    // Quadro em composição
+    Celula anterior[TELA_LINHAS][TELA_COLUNAS]; // Último quadro enviado ao terminal
+    int valida;                                 // 0 = o terminal não mostra `anterior`
+    int cursor_linha, cursor_coluna;            // Onde o último quadro deixou o cursor
+    int linha, coluna;                          // Posição de composição (vira o cursor final)
+    uint8_t estilo;                             // Estilo em composição
+    char estilos[TELA_MAX_ESTILOS][TELA_ESTILO_TAMANHO]; // Sequências SGR de cada estilo
+    int n_estilos;
+    char* saida;                                // Bytes do quadro a enviar
+    size_t saida_n, saida_capacidade;
+    TelaEstatisticas stats;
+} Tela;
+
+int tela_iniciar(Tela* tela);
+void tela_liberar(Tela* tela);
+
+// Começa um quadro novo: grade em branco, composição em (0, 0) sem estilo
+void tela_limpar(Tela* tela);
+
+// Escreve texto formatado na posição de composição
+void tela_printf(Tela* tela, const char* formato, ...);
+
+/*
+    Envia ao terminal (fd) as diferenças em relação ao quadro anterior, em um
+    único write, e deixa o cursor na posição final da composição
+    @return: Bytes escritos
+*/
+size_t tela_apresentar(Tela* tela, int fd);
+
+// O terminal foi alterado por fora: o próximo quadro limpa e redesenha tudo
+void tela_invalidar(Tela* tela);
+
+#endif